@@ -0,0 +1,151 @@
+/**
+ * @file alphaBroadcast.cpp
+ * @brief Реализация шифрования одного текста под многими ключами
+ * @author Назарова Софья
+ * @date 2025
+ * @copyright WECT ПГУ
+ */
+
+#include "alphaBroadcast.h"
+#include <algorithm>
+#include <map>
+
+namespace {
+    const unsigned alphabetSize = 33; ///< Размер алфавита шифра (с буквой Ё)
+    const size_t blockLetters = 64; ///< Позиций текста в одном блоке обработки
+
+    /**
+     * @brief Шифрование одной буквы текста под ключами группы
+     * @param[in] p Номер буквы открытого текста
+     * @param[in] shift Номера букв ключей группы в текущей позиции
+     * @param[out] lane Номера букв шифртекста
+     * @param[in] count Количество ключей группы
+     * @details Указатели не пересекаются (__restrict), поэтому цикл
+     *          векторизуется без проверок перекрытия
+     */
+    inline void shiftLanes(uint8_t p, const uint8_t* __restrict shift,
+                           uint8_t* __restrict lane, size_t count) {
+        for (size_t k = 0; k < count; k++) {
+            uint8_t c = p + shift[k];
+            lane[k] = c >= alphabetSize ? c - alphabetSize : c;
+        }
+    }
+}
+
+/**
+ * @brief Конструктор с набором ключей
+ * @param[in] keys Ключи шифрования
+ * @throw cipher_error при пустом наборе, слабом или невалидном ключе
+ * @details Каждый ключ проверяется конструктором modAlphaCipher, чтобы
+ *          правила и сообщения об ошибках совпадали с обычным шифрованием.
+ *          Ключи группируются по длине, полосы плитки идут по группам
+ */
+alphaBroadcast::alphaBroadcast(const std::vector<std::string>& keys) {
+    if (keys.empty())
+        throw cipher_error("Пустой набор ключей");
+    std::vector<std::vector<uint8_t>> letters;
+    std::map<size_t, std::vector<uint32_t>> byLength;
+    for (const std::string& key : keys) {
+        modAlphaCipher check(key);
+        letters.push_back(letterIndices(key, true));
+        byLength[letters.back().size()].push_back(letters.size() - 1);
+    }
+    for (const auto& g : byLength) {
+        lengthGroup group;
+        group.length = g.first;
+        group.first = keyOfLane.size();
+        group.count = g.second.size();
+        group.table = keyTable.size();
+        for (size_t j = 0; j < group.length; j++)
+            for (uint32_t k : g.second)
+                keyTable.push_back(letters[k][j]);
+        keyOfLane.insert(keyOfLane.end(), g.second.begin(), g.second.end());
+        groups.push_back(group);
+    }
+}
+
+/**
+ * @brief Номера русских букв текста в алфавите шифра
+ * @param[in] s Текст
+ * @param[in] strict true - допустимы только буквы (для ключа)
+ * @return Номера букв
+ * @details Алфавит шифра - А..Я с буквой Ё на 6-м месте; строчные
+ *          буквы приводятся к заглавным, прочие символы отбрасываются
+ */
+std::vector<uint8_t> alphaBroadcast::letterIndices(const std::string& s, bool strict) {
+    std::vector<uint8_t> result;
+    result.reserve(s.size() / 2);
+    for (size_t i = 0; i < s.size(); ) {
+        char32_t cp = modAlphaCipher::decodeUtf8(s, i);
+        if (cp >= 0x410 && cp <= 0x44F) {
+            unsigned n = (cp - 0x410) % 32;
+            result.push_back(n < 6 ? n : n + 1);
+            continue;
+        }
+        if (strict)
+            throw cipher_error("Неверный ключ: содержит не-буквенные символы");
+    }
+    return result;
+}
+
+/**
+ * @brief Шифрование текста под всеми ключами
+ * @param[in] open_text Открытый текст
+ * @return Шифртексты в порядке ключей
+ * @throw cipher_error при тексте без русских букв или некорректной UTF-8
+ * @details Текст обрабатывается блоками по blockLetters позиций. Для каждой
+ *          позиции циклы по ключам каждой группы пишут номера букв шифртекста
+ *          в плитку [позиция][полоса]; затем плитка переводится в UTF-8 и выписывается
+ *          в буфер результата непрерывными отрезками по каждому ключу
+ */
+broadcastText alphaBroadcast::encrypt(const std::string& open_text) const {
+    std::vector<uint8_t> plain = letterIndices(open_text, false);
+    if (plain.empty())
+        throw cipher_error("Отсутствует открытый текст!");
+
+    static const char utf8[alphabetSize][2] = {
+        {'\xD0', '\x90'}, {'\xD0', '\x91'}, {'\xD0', '\x92'}, {'\xD0', '\x93'},
+        {'\xD0', '\x94'}, {'\xD0', '\x95'}, {'\xD0', '\x81'}, {'\xD0', '\x96'},
+        {'\xD0', '\x97'}, {'\xD0', '\x98'}, {'\xD0', '\x99'}, {'\xD0', '\x9A'},
+        {'\xD0', '\x9B'}, {'\xD0', '\x9C'}, {'\xD0', '\x9D'}, {'\xD0', '\x9E'},
+        {'\xD0', '\x9F'}, {'\xD0', '\xA0'}, {'\xD0', '\xA1'}, {'\xD0', '\xA2'},
+        {'\xD0', '\xA3'}, {'\xD0', '\xA4'}, {'\xD0', '\xA5'}, {'\xD0', '\xA6'},
+        {'\xD0', '\xA7'}, {'\xD0', '\xA8'}, {'\xD0', '\xA9'}, {'\xD0', '\xAA'},
+        {'\xD0', '\xAB'}, {'\xD0', '\xAC'}, {'\xD0', '\xAD'}, {'\xD0', '\xAE'},
+        {'\xD0', '\xAF'}
+    }; ///< Буквы алфавита шифра в UTF-8
+
+    const size_t keys = size();
+    const size_t letters = plain.size();
+    broadcastText result;
+    result.letters = letters;
+    result.count = keys;
+    result.arena.resize(keys * 2 * letters);
+    char* arena = &result.arena[0];
+
+    std::vector<uint32_t> phase(groups.size(), 0);
+    std::vector<uint8_t> tile(blockLetters * keys);
+
+    for (size_t block = 0; block < letters; block += blockLetters) {
+        size_t n = std::min(blockLetters, letters - block);
+        for (size_t i = 0; i < n; i++) {
+            uint8_t* lane = &tile[i * keys];
+            uint8_t p = plain[block + i];
+            for (size_t g = 0; g < groups.size(); g++) {
+                const lengthGroup& group = groups[g];
+                shiftLanes(p, &keyTable[group.table + phase[g] * group.count],
+                           lane + group.first, group.count);
+                phase[g] = phase[g] + 1 == group.length ? 0 : phase[g] + 1;
+            }
+        }
+        for (size_t k = 0; k < keys; k++) {
+            char* out = arena + keyOfLane[k] * 2 * letters + 2 * block;
+            for (size_t i = 0; i < n; i++) {
+                const char* u = utf8[tile[i * keys + k]];
+                out[2 * i] = u[0];
+                out[2 * i + 1] = u[1];
+            }
+        }
+    }
+    return result;
+}
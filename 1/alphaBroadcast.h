@@ -0,0 +1,109 @@
+/**
+ * @file alphaBroadcast.h
+ * @brief Шифрование одного текста modAlphaCipher под многими ключами
+ * @author Назарова Софья
+ * @date 2025
+ */
+
+#pragma once
+#include "modAlphaCipher.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class broadcastText
+ * @brief Шифртексты для всех ключей в одном буфере
+ * @details Шифртекст для k-го ключа занимает байты
+ *          [k * 2 * letters, (k + 1) * 2 * letters) буфера
+ */
+class broadcastText {
+    public:
+        /**
+         * @brief Шифртекст для ключа
+         * @param[in] k Номер ключа
+         * @return Шифртекст (действителен, пока жив объект)
+         */
+        std::string_view operator[](size_t k) const {
+            return std::string_view(arena.data() + k * 2 * letters, 2 * letters);
+        }
+
+        /**
+         * @brief Количество шифртекстов
+         * @return Количество ключей
+         */
+        size_t size() const { return count; }
+
+    private:
+        friend class alphaBroadcast;
+        std::string arena; ///< Все шифртексты подряд
+        size_t letters = 0; ///< Количество букв в каждом шифртексте
+        size_t count = 0; ///< Количество ключей
+};
+
+/**
+ * @class alphaBroadcast
+ * @brief Шифрование одного открытого текста под набором ключей
+ * @details Открытый текст проверяется и переводится в номера букв один раз.
+ *          Ключи одной длины всегда находятся в одной позиции своего периода,
+ *          поэтому они объединяются в группы, а буквы группы хранятся
+ *          таблицей [позиция в ключе][ключ] (structure of arrays). Для
+ *          очередной буквы текста буквы всех ключей группы лежат подряд,
+ *          и цикл по ключам группы векторизуется без выборки по индексам:
+ *          каждая полоса SIMD обрабатывает свой ключ
+ */
+class alphaBroadcast {
+    public:
+        /**
+         * @brief Удаленный конструктор по умолчанию
+         */
+        alphaBroadcast() = delete;
+
+        /**
+         * @brief Конструктор с набором ключей
+         * @param[in] keys Ключи шифрования
+         * @throw cipher_error при пустом наборе, слабом или невалидном ключе
+         */
+        explicit alphaBroadcast(const std::vector<std::string>& keys);
+
+        /**
+         * @brief Шифрование текста под всеми ключами
+         * @param[in] open_text Открытый текст
+         * @return Шифртексты в порядке ключей; k-й совпадает с
+         *         modAlphaCipher(keys[k]).encrypt(open_text)
+         * @throw cipher_error при тексте без русских букв или некорректной UTF-8
+         */
+        broadcastText encrypt(const std::string& open_text) const;
+
+        /**
+         * @brief Количество ключей
+         * @return Количество ключей
+         */
+        size_t size() const { return keyOfLane.size(); }
+
+    private:
+        /**
+         * @brief Номера русских букв текста в алфавите шифра
+         * @param[in] s Текст
+         * @param[in] strict true - допустимы только буквы (для ключа)
+         * @return Номера букв
+         * @throw cipher_error при некорректной UTF-8 или не-буквенных символах в строгом режиме
+         */
+        static std::vector<uint8_t> letterIndices(const std::string& s, bool strict);
+
+        /**
+         * @struct lengthGroup
+         * @brief Ключи одной длины
+         */
+        struct lengthGroup {
+            uint32_t length; ///< Длина ключей группы
+            uint32_t first; ///< Первая полоса группы в плитке
+            uint32_t count; ///< Количество ключей группы
+            size_t table; ///< Начало таблицы группы в keyTable
+        };
+
+        std::vector<uint8_t> keyTable; ///< Номера букв ключей: по группам, [позиция][ключ группы]
+        std::vector<lengthGroup> groups; ///< Группы ключей по возрастанию длины
+        std::vector<uint32_t> keyOfLane; ///< Номер ключа для каждой полосы плитки
+};
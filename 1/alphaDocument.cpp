@@ -0,0 +1,167 @@
+/**
+ * @file alphaDocument.cpp
+ * @brief Реализация документа с инкрементальным шифрованием
+ * @author Назарова Софья
+ * @date 2025
+ * @copyright WECT ПГУ
+ */
+
+#include "alphaDocument.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Конструктор с ключом и начальным текстом
+ * @param[in] key Ключ шифрования
+ * @param[in] text Начальный текст
+ * @throw cipher_error при слабом или невалидном ключе
+ * @details Длина ключа в буквах - количество символов UTF-8 в ключе,
+ *          так как modAlphaCipher допускает в ключе только буквы
+ */
+alphaDocument::alphaDocument(const std::string& key, const std::string& text):
+    cipher(key), period(0) {
+    for (unsigned char c : key)
+        if ((c & 0xC0) != 0x80)
+            period++;
+    insert(0, text);
+}
+
+/**
+ * @brief Поиск узла, содержащего букву
+ * @param[in,out] pos Позиция в документе; на выходе - позиция в узле
+ * @return Номер узла (nodes.size(), если pos == size())
+ */
+size_t alphaDocument::locate(size_t& pos) const {
+    size_t i = 0;
+    while (i < nodes.size() && pos >= nodes[i].letters) {
+        pos -= nodes[i].letters;
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief Деление переполненного узла на узлы по nodeLetters букв
+ * @param[in] index Номер узла
+ */
+void alphaDocument::split(size_t index) {
+    if (nodes[index].letters <= 2 * nodeLetters)
+        return;
+    std::string plain = std::move(nodes[index].plain);
+    std::vector<node> parts;
+    for (size_t pos = 0; pos < plain.size(); pos += 2 * nodeLetters) {
+        node n;
+        n.plain = plain.substr(pos, 2 * nodeLetters);
+        n.letters = n.plain.size() / 2;
+        parts.push_back(std::move(n));
+    }
+    nodes.erase(nodes.begin() + index);
+    nodes.insert(nodes.begin() + index, parts.begin(), parts.end());
+}
+
+/**
+ * @brief Вставка текста
+ * @param[in] pos Позиция вставки в буквах
+ * @param[in] text Вставляемый текст
+ * @throw std::out_of_range если pos больше size()
+ * @throw cipher_error при некорректной последовательности UTF-8
+ */
+void alphaDocument::insert(size_t pos, const std::string& text) {
+    if (pos > letters)
+        throw std::out_of_range("Позиция за концом документа");
+    std::string add;
+    modAlphaCipher::russianLetters(text, add);
+    if (add.empty())
+        return;
+
+    size_t i = locate(pos);
+    if (i == nodes.size()) {
+        // Вставка в конец: дописываем последний узел
+        if (i > 0) {
+            i--;
+            pos = nodes[i].letters;
+        } else {
+            nodes.emplace_back();
+        }
+    }
+    node& n = nodes[i];
+    n.plain.insert(2 * pos, add);
+    n.letters += add.size() / 2;
+    n.dirty = true;
+    letters += add.size() / 2;
+    split(i);
+}
+
+/**
+ * @brief Удаление букв
+ * @param[in] pos Позиция первой удаляемой буквы
+ * @param[in] count Количество букв
+ * @throw std::out_of_range если pos больше size()
+ */
+void alphaDocument::erase(size_t pos, size_t count) {
+    if (pos > letters)
+        throw std::out_of_range("Позиция за концом документа");
+    count = std::min(count, letters - pos);
+    letters -= count;
+
+    size_t i = locate(pos);
+    while (count > 0) {
+        node& n = nodes[i];
+        size_t k = std::min(count, n.letters - pos);
+        n.plain.erase(2 * pos, 2 * k);
+        n.letters -= k;
+        n.dirty = true;
+        count -= k;
+        if (n.letters == 0) {
+            nodes.erase(nodes.begin() + i);
+        } else {
+            i++;
+        }
+        pos = 0;
+    }
+
+    // Слияние узла на месте удаления со следующим, если оба стали малы
+    if (i > 0 && i < nodes.size() && nodes[i - 1].letters + nodes[i].letters <= nodeLetters) {
+        nodes[i - 1].plain += nodes[i].plain;
+        nodes[i - 1].letters += nodes[i].letters;
+        nodes[i - 1].dirty = true;
+        nodes.erase(nodes.begin() + i);
+    }
+}
+
+/**
+ * @brief Открытый текст
+ * @return Заглавные русские буквы
+ */
+std::string alphaDocument::text() const {
+    std::string result;
+    result.reserve(2 * letters);
+    for (const node& n : nodes)
+        result += n.plain;
+    return result;
+}
+
+/**
+ * @brief Шифртекст всего документа
+ * @return То же, что modAlphaCipher::encrypt(text())
+ * @details Узел перешифровывается, если он изменен или его первая буква
+ *          попала на другую позицию ключа. Остальные узлы берутся из кэша
+ */
+std::string alphaDocument::cipherText() {
+    std::string result;
+    result.reserve(2 * letters);
+    reencrypted = 0;
+    size_t offset = 0;
+    for (node& n : nodes) {
+        size_t phase = offset % period;
+        if (n.dirty || n.phase != phase) {
+            n.cipher = cipher.encrypt(n.plain, phase);
+            n.phase = phase;
+            n.dirty = false;
+            reencrypted += n.letters;
+        }
+        result += n.cipher;
+        offset += n.letters;
+    }
+    return result;
+}
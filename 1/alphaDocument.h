@@ -0,0 +1,115 @@
+/**
+ * @file alphaDocument.h
+ * @brief Документ с инкрементальным шифрованием modAlphaCipher
+ * @author Назарова Софья
+ * @date 2025
+ */
+
+#pragma once
+#include "modAlphaCipher.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class alphaDocument
+ * @brief Открытый текст, который правится по частям, и его шифртекст
+ * @details Текст хранится последовательностью узлов (piece table)
+ *          с количеством букв в каждом. Для каждого узла запоминается
+ *          шифртекст и фаза ключа (номер первой буквы узла по модулю
+ *          длины ключа), с которой он получен. После правки
+ *          перешифровываются только измененные узлы и узлы после места
+ *          правки, у которых сдвинулась фаза. Если длина вставки или
+ *          удаления кратна длине ключа, фаза следующих узлов не меняется
+ *          и их шифртекст используется повторно
+ */
+class alphaDocument {
+    public:
+        /**
+         * @brief Удаленный конструктор по умолчанию
+         */
+        alphaDocument() = delete;
+
+        /**
+         * @brief Конструктор с ключом и начальным текстом
+         * @param[in] key Ключ шифрования
+         * @param[in] text Начальный текст
+         * @throw cipher_error при слабом или невалидном ключе
+         */
+        alphaDocument(const std::string& key, const std::string& text = "");
+
+        /**
+         * @brief Вставка текста
+         * @param[in] pos Позиция вставки в буквах
+         * @param[in] text Вставляемый текст (не-буквы отбрасываются, как в encrypt)
+         * @throw std::out_of_range если pos больше size()
+         * @throw cipher_error при некорректной последовательности UTF-8
+         */
+        void insert(size_t pos, const std::string& text);
+
+        /**
+         * @brief Удаление букв
+         * @param[in] pos Позиция первой удаляемой буквы
+         * @param[in] count Количество букв (обрезается по концу текста)
+         * @throw std::out_of_range если pos больше size()
+         */
+        void erase(size_t pos, size_t count);
+
+        /**
+         * @brief Количество букв в тексте
+         * @return Количество букв
+         */
+        size_t size() const { return letters; }
+
+        /**
+         * @brief Открытый текст
+         * @return Заглавные русские буквы
+         */
+        std::string text() const;
+
+        /**
+         * @brief Шифртекст всего документа
+         * @return То же, что modAlphaCipher::encrypt(text())
+         * @details Перешифровывает только узлы с устаревшим шифртекстом
+         */
+        std::string cipherText();
+
+        /**
+         * @brief Количество букв, перешифрованных последним вызовом cipherText()
+         * @return Количество букв
+         */
+        size_t lastReencrypted() const { return reencrypted; }
+
+    private:
+        /**
+         * @struct node
+         * @brief Узел текста
+         */
+        struct node {
+            std::string plain; ///< Открытый текст узла (по 2 байта на букву)
+            std::string cipher; ///< Шифртекст узла
+            size_t letters = 0; ///< Количество букв
+            size_t phase = 0; ///< Фаза ключа, с которой получен cipher
+            bool dirty = true; ///< cipher не соответствует plain
+        };
+
+        /**
+         * @brief Поиск узла, содержащего букву
+         * @param[in,out] pos Позиция в документе; на выходе - позиция в узле
+         * @return Номер узла (nodes.size(), если pos == size())
+         */
+        size_t locate(size_t& pos) const;
+
+        /**
+         * @brief Деление переполненного узла на узлы по nodeLetters букв
+         * @param[in] index Номер узла
+         */
+        void split(size_t index);
+
+        static const size_t nodeLetters = 512; ///< Размер узла при делении, букв
+
+        modAlphaCipher cipher; ///< Шифр
+        size_t period; ///< Длина ключа в буквах
+        std::vector<node> nodes; ///< Узлы текста
+        size_t letters = 0; ///< Количество букв в тексте
+        size_t reencrypted = 0; ///< Перешифровано последним cipherText()
+};
@@ -8,6 +8,8 @@
 
 #include <UnitTest++/UnitTest++.h>
 #include "modAlphaCipher.h"
+#include "alphaDocument.h"
+#include "alphaBroadcast.h"
 
 /**
  * @test Suite KeyTest
@@ -169,6 +171,16 @@ SUITE(EncryptTest)
         std::string result = cipher.encrypt("СУП");
         CHECK(!result.empty());
     }
+
+    /**
+     * @test OffsetEncrypt
+     * @brief Шифрование по частям со смещением совпадает с шифрованием целиком
+     */
+    TEST_FIXTURE(SimpleFixture, OffsetEncrypt) {
+        std::string whole = p->encrypt("СУПСФРИКАДЕЛЬКАМИ");
+        CHECK_EQUAL(whole, p->encrypt("СУПСФ") + p->encrypt("РИКАДЕЛЬКАМИ", 5));
+        CHECK_EQUAL("РИКАДЕЛЬКАМИ", p->decrypt(p->encrypt("РИКАДЕЛЬКАМИ", 5), 5));
+    }
 }
 
 /**
@@ -237,6 +249,139 @@ SUITE(DecryptTest)
     }
 }
 
+/**
+ * @test Suite DocumentTest
+ * @brief Тесты для инкрементального шифрования документа
+ */
+SUITE(DocumentTest)
+{
+    /**
+     * @test Edits
+     * @brief После правок шифртекст совпадает с шифрованием всего текста
+     */
+    TEST(Edits) {
+        modAlphaCipher cipher("БОРЩ");
+        alphaDocument doc("БОРЩ", "Суп с фрикадельками");
+        CHECK_EQUAL(cipher.encrypt("Суп с фрикадельками"), doc.cipherText());
+        doc.insert(3, "овой");
+        doc.erase(0, 1);
+        doc.insert(doc.size(), ", каша!");
+        CHECK_EQUAL("УПОВОЙСФРИКАДЕЛЬКАМИКАША", doc.text());
+        CHECK_EQUAL(cipher.encrypt(doc.text()), doc.cipherText());
+    }
+
+    /**
+     * @test KeyPeriodInsert
+     * @brief Вставка длины, кратной ключу, не перешифровывает остаток документа
+     */
+    TEST(KeyPeriodInsert) {
+        std::string text;
+        for (int i = 0; i < 1000; i++)
+            text += "СУПСФРИКАДЕЛЬКАМИ";
+        alphaDocument doc("БОРЩ", text);
+        doc.cipherText();
+        doc.insert(100, "КАША");
+        std::string result = doc.cipherText();
+        CHECK(doc.lastReencrypted() < doc.size() / 4);
+        CHECK_EQUAL(modAlphaCipher("БОРЩ").encrypt(doc.text()), result);
+    }
+
+    /**
+     * @test OutOfRange
+     * @brief Правка за концом документа (ожидается исключение)
+     */
+    TEST(OutOfRange) {
+        alphaDocument doc("БОРЩ", "СУП");
+        CHECK_THROW(doc.insert(4, "А"), std::out_of_range);
+        CHECK_THROW(doc.erase(4, 1), std::out_of_range);
+    }
+
+    /**
+     * @test MalformedUtf8
+     * @brief Вставка некорректной UTF-8 (ожидается исключение)
+     */
+    TEST(MalformedUtf8) {
+        alphaDocument doc("БОРЩ", "СУП");
+        CHECK_THROW(doc.insert(0, "\xD0"), cipher_error);
+        CHECK_THROW(doc.insert(0, "\xD0\x41"), cipher_error);
+        CHECK_THROW(doc.insert(0, "\x91\xD0\x90"), cipher_error);
+        CHECK_EQUAL("СУП", doc.text());
+    }
+}
+
+/**
+ * @test Suite BroadcastTest
+ * @brief Тесты для шифрования одного текста под многими ключами
+ */
+SUITE(BroadcastTest)
+{
+    /**
+     * @test SameAsSingle
+     * @brief Каждый шифртекст совпадает с шифрованием отдельным ключом
+     */
+    TEST(SameAsSingle) {
+        std::vector<std::string> keys = {"БОРЩ", "Я", "ПОМИДОРЫ", "йцу"};
+        alphaBroadcast cipher(keys);
+        broadcastText result = cipher.encrypt("Суп с фрикадельками, 2 порции");
+        CHECK_EQUAL(keys.size(), result.size());
+        for (size_t k = 0; k < keys.size(); k++)
+            CHECK_EQUAL(modAlphaCipher(keys[k]).encrypt("Суп с фрикадельками, 2 порции"),
+                        std::string(result[k]));
+    }
+
+    /**
+     * @test ManyKeys
+     * @brief Много ключей нескольких длин (полные векторы SIMD в каждой группе)
+     */
+    TEST(ManyKeys) {
+        const std::string alphabet = "АБВГДЕЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        std::vector<std::string> keys;
+        for (size_t k = 0; k < 100; k++) {
+            std::string key;
+            for (size_t i = 0; i < 3 + k % 3; i++)
+                key += alphabet.substr(2 * ((k * 7 + i * 11) % 32), 2);
+            keys.push_back(key);
+        }
+        std::string text = "Съешь же ещё этих мягких французских булок, да выпей чаю";
+        broadcastText result = alphaBroadcast(keys).encrypt(text);
+        for (size_t k = 0; k < keys.size(); k++)
+            CHECK_EQUAL(modAlphaCipher(keys[k]).encrypt(text), std::string(result[k]));
+    }
+
+    /**
+     * @test BadKeys
+     * @brief Пустой набор, слабый или невалидный ключ (ожидается исключение)
+     */
+    TEST(BadKeys) {
+        std::vector<std::string> none;
+        std::vector<std::string> weak = {"БОРЩ", "ЙЙЙ"};
+        std::vector<std::string> digits = {"Й1"};
+        CHECK_THROW(alphaBroadcast cp(none), cipher_error);
+        CHECK_THROW(alphaBroadcast cp(weak), cipher_error);
+        CHECK_THROW(alphaBroadcast cp(digits), cipher_error);
+    }
+
+    /**
+     * @test NoAlphaText
+     * @brief Текст без букв (ожидается исключение)
+     */
+    TEST(NoAlphaText) {
+        alphaBroadcast cipher(std::vector<std::string>(1, "БОРЩ"));
+        CHECK_THROW(cipher.encrypt("*_*"), cipher_error);
+    }
+
+    /**
+     * @test MalformedUtf8
+     * @brief Некорректная UTF-8 в ключе или тексте (ожидается исключение)
+     */
+    TEST(MalformedUtf8) {
+        std::vector<std::string> broken = {"БОРЩ", "\xD0\x91\xD0"};
+        CHECK_THROW(alphaBroadcast cp(broken), cipher_error);
+        alphaBroadcast cipher(std::vector<std::string>(1, "БОРЩ"));
+        CHECK_THROW(cipher.encrypt("СУП\xD1\xC1"), cipher_error);
+    }
+}
+
 /**
  * @brief Главная функция для запуска тестов
  * @param[in] argc Количество аргументов командной строки
@@ -11,7 +11,7 @@
 #include <codecvt>
 #include <iostream>
 
-std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> codec; ///< Конвертер UTF-8
+thread_local std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> codec; ///< Конвертер UTF-8 (свой в каждом потоке)
 
 /**
  * @brief Конструктор с ключом
@@ -46,37 +46,132 @@ modAlphaCipher::modAlphaCipher(const std::string& skey) {
  * @throw cipher_error при ошибках валидации
  * @details Алгоритм: C_i = (P_i + K_{i mod len(K)}) mod N
  */
-std::string modAlphaCipher::encrypt(const std::string& open_text) {
+std::string modAlphaCipher::encrypt(const std::string& open_text) const {
+    return encrypt(open_text, 0);
+}
+
+/**
+ * @brief Дешифрование текста
+ * @param[in] cipher_text Зашифрованный текст
+ * @return Расшифрованный текст
+ * @throw cipher_error при ошибках валидации
+ * @details Алгоритм: P_i = (C_i - K_{i mod len(K)} + N) mod N
+ */
+std::string modAlphaCipher::decrypt(const std::string& cipher_text) const {
+    return decrypt(cipher_text, 0);
+}
+
+/**
+ * @brief Шифрование фрагмента текста
+ * @param[in] open_text Открытый текст для шифрования
+ * @param[in] offset Количество букв текста, предшествующих фрагменту
+ * @return Зашифрованный текст
+ * @throw cipher_error при ошибках валидации
+ * @details Алгоритм: C_i = (P_i + K_{(i + offset) mod len(K)}) mod N
+ */
+std::string modAlphaCipher::encrypt(const std::string& open_text, size_t offset) const {
     std::vector<int> work = convert(getValidOpenText(open_text));
     for(unsigned i=0; i < work.size(); i++)
-        work[i] = (work[i] + key[i % key.size()]) % alphaNum.size();
+        work[i] = (work[i] + key[(i + offset) % key.size()]) % alphaNum.size();
     return convert(work);
 }
 
 /**
- * @brief Дешифрование текста
+ * @brief Дешифрование фрагмента текста
  * @param[in] cipher_text Зашифрованный текст
+ * @param[in] offset Количество букв текста, предшествующих фрагменту
  * @return Расшифрованный текст
  * @throw cipher_error при ошибках валидации
- * @details Алгоритм: P_i = (C_i - K_{i mod len(K)} + N) mod N
+ * @details Алгоритм: P_i = (C_i - K_{(i + offset) mod len(K)} + N) mod N
  */
-std::string modAlphaCipher::decrypt(const std::string& cipher_text) {
+std::string modAlphaCipher::decrypt(const std::string& cipher_text, size_t offset) const {
     std::vector<int> work = convert(getValidCipherText(cipher_text));
     for(unsigned i=0; i < work.size(); i++)
-        work[i] = (work[i] + alphaNum.size() - key[i % key.size()]) % alphaNum.size();
+        work[i] = (work[i] + alphaNum.size() - key[(i + offset) % key.size()]) % alphaNum.size();
     return convert(work);
 }
 
+/**
+ * @brief Декодирование одного символа UTF-8 с проверкой
+ * @param[in] s Строка в UTF-8
+ * @param[in,out] pos Позиция первого байта символа; на выходе - следующего
+ * @return Кодовая точка символа
+ * @throw cipher_error при некорректной последовательности UTF-8
+ */
+char32_t modAlphaCipher::decodeUtf8(std::string_view s, size_t& pos) {
+    unsigned char c = s[pos];
+    if (c < 0x80) {
+        pos++;
+        return c;
+    }
+    size_t extra;
+    char32_t cp;
+    unsigned char low = 0x80, high = 0xBF; // допустимый диапазон второго байта
+    if (c >= 0xC2 && c <= 0xDF) {
+        extra = 1;
+        cp = c & 0x1F;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        extra = 2;
+        cp = c & 0x0F;
+        if (c == 0xE0)
+            low = 0xA0;  // избыточная форма
+        else if (c == 0xED)
+            high = 0x9F; // суррогаты
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        extra = 3;
+        cp = c & 0x07;
+        if (c == 0xF0)
+            low = 0x90;  // избыточная форма
+        else if (c == 0xF4)
+            high = 0x8F; // больше U+10FFFF
+    } else {
+        throw cipher_error("Некорректная последовательность UTF-8");
+    }
+    if (s.size() - pos <= extra)
+        throw cipher_error("Некорректная последовательность UTF-8");
+    for (size_t k = 1; k <= extra; k++) {
+        unsigned char b = s[pos + k];
+        if (b < (k == 1 ? low : 0x80) || b > (k == 1 ? high : 0xBF))
+            throw cipher_error("Некорректная последовательность UTF-8");
+        cp = (cp << 6) | (b & 0x3F);
+    }
+    pos += extra + 1;
+    return cp;
+}
+
+/**
+ * @brief Выделение русских букв текста
+ * @param[in] s Текст в UTF-8
+ * @param[in,out] out Буфер, в конец которого дописываются заглавные русские буквы в UTF-8
+ * @throw cipher_error при некорректной последовательности UTF-8
+ */
+void modAlphaCipher::russianLetters(std::string_view s, std::string& out) {
+    out.reserve(out.size() + s.size());
+    for (size_t i = 0; i < s.size(); ) {
+        char32_t cp = decodeUtf8(s, i);
+        if (cp >= 0x410 && cp <= 0x44F) {
+            if (cp >= 0x430)
+                cp -= 32;  // преобразование в заглавные
+            out.push_back(0xC0 | (cp >> 6));
+            out.push_back(0x80 | (cp & 0x3F));
+        }
+    }
+}
+
 /**
  * @brief Преобразование строки в вектор числовых индексов
  * @param[in] s Входная строка
  * @return Вектор индексов символов
  */
-std::vector<int> modAlphaCipher::convert(const std::string& s) {
+std::vector<int> modAlphaCipher::convert(const std::string& s) const {
     std::wstring ws = codec.from_bytes(s);
     std::vector<int> result;
-    for(auto c:ws)
-        result.push_back(alphaNum[c]);
+    for(auto c:ws) {
+        auto it = alphaNum.find(c);
+        if (it == alphaNum.end())
+            throw cipher_error("Символ вне алфавита");
+        result.push_back(it->second);
+    }
     return result;
 }
 
@@ -85,10 +180,10 @@ std::vector<int> modAlphaCipher::convert(const std::string& s) {
  * @param[in] v Вектор индексов
  * @return Результирующая строка
  */
-std::string modAlphaCipher::convert(const std::vector<int>& v) {
+std::string modAlphaCipher::convert(const std::vector<int>& v) const {
     std::wstring ws;
     for(auto i:v)
-        ws.push_back(numAlpha[i]);
+        ws.push_back(numAlpha.at(i));
     std::string result = codec.to_bytes(ws);
     return result;
 }
@@ -99,7 +194,7 @@ std::string modAlphaCipher::convert(const std::vector<int>& v) {
  * @return Валидированный ключ (все символы заглавные)
  * @throw cipher_error при пустом ключе или не-буквенных символах
  */
-std::string modAlphaCipher::getValidKey(const std::string & s) {
+std::string modAlphaCipher::getValidKey(const std::string & s) const {
     std::wstring ws = codec.from_bytes(s);
     if (ws.empty())
         throw cipher_error("Пустой ключ");
@@ -122,7 +217,7 @@ std::string modAlphaCipher::getValidKey(const std::string & s) {
  * @return Валидированный текст (только заглавные русские буквы)
  * @throw cipher_error при пустом тексте
  */
-std::string modAlphaCipher::getValidOpenText(const std::string & s) {
+std::string modAlphaCipher::getValidOpenText(const std::string & s) const {
     std::wstring ws = codec.from_bytes(s);
     std::wstring tmp;
     
@@ -148,7 +243,7 @@ std::string modAlphaCipher::getValidOpenText(const std::string & s) {
  * @return Валидированный текст
  * @throw cipher_error при пустом тексте или недопустимых символах
  */
-std::string modAlphaCipher::getValidCipherText(const std::string & s) {
+std::string modAlphaCipher::getValidCipherText(const std::string & s) const {
     std::wstring ws = codec.from_bytes(s);
     
     if (ws.empty())
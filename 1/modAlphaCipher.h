@@ -1,39 +1,20 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
 #include <stdexcept>
 #include <locale>
 #include <codecvt>
-
-/**
- * @class cipher_error
- * @brief Исключение для ошибок шифрования
- * @details Наследуется от std::invalid_argument, используется для обработки ошибок
- *          при работе с шифром
- */
-class cipher_error: public std::invalid_argument {
-    public:
-        /**
-         * @brief Конструктор с строкой
-         * @param[in] what_arg Сообщение об ошибке
-         */
-        explicit cipher_error (const std::string& what_arg):
-        std::invalid_argument(what_arg) {}
-        
-        /**
-         * @brief Конструктор с си-строкой
-         * @param[in] what_arg Сообщение об ошибке
-         */
-        explicit cipher_error (const char* what_arg):
-        std::invalid_argument(what_arg) {}
-};
+#include "../common/cipher_error.h"
 
 /**
  * @class modAlphaCipher
  * @brief Класс для шифрования методом модифицированного алфавитного шифра
  * @details Реализует шифрование с использованием ключа на основе русского алфавита.
  *          Поддерживает только русские буквы, автоматически преобразует регистр.
+ *          Методы encrypt/decrypt константны и могут вызываться для одного
+ *          объекта из нескольких потоков одновременно.
  */
 class modAlphaCipher {
     private:
@@ -46,14 +27,14 @@ class modAlphaCipher {
          * @param[in] s Входная строка
          * @return Вектор индексов символов
          */
-        std::vector<int> convert(const std::string& s);
+        std::vector<int> convert(const std::string& s) const;
         
         /**
          * @brief Преобразование вектора индексов в строку
          * @param[in] v Вектор индексов
          * @return Результирующая строка
          */
-        std::string convert(const std::vector<int>& v);
+        std::string convert(const std::vector<int>& v) const;
         
         /**
          * @brief Проверка и нормализация ключа
@@ -61,7 +42,7 @@ class modAlphaCipher {
          * @return Валидированный ключ
          * @throw cipher_error при невалидном ключе
          */
-        std::string getValidKey(const std::string & s);
+        std::string getValidKey(const std::string & s) const;
         
         /**
          * @brief Проверка и нормализация открытого текста
@@ -69,7 +50,7 @@ class modAlphaCipher {
          * @return Валидированный текст
          * @throw cipher_error при невалидном тексте
          */
-        std::string getValidOpenText(const std::string & s);
+        std::string getValidOpenText(const std::string & s) const;
         
         /**
          * @brief Проверка зашифрованного текста
@@ -77,7 +58,7 @@ class modAlphaCipher {
          * @return Валидированный текст
          * @throw cipher_error при невалидном тексте
          */
-        std::string getValidCipherText(const std::string & s);
+        std::string getValidCipherText(const std::string & s) const;
         
     public:
         /**
@@ -98,7 +79,7 @@ class modAlphaCipher {
          * @return Зашифрованный текст
          * @throw cipher_error при ошибках валидации
          */
-        std::string encrypt(const std::string& open_text);
+        std::string encrypt(const std::string& open_text) const;
         
         /**
          * @brief Дешифрование текста
@@ -106,5 +87,45 @@ class modAlphaCipher {
          * @return Расшифрованный текст
          * @throw cipher_error при ошибках валидации
          */
-        std::string decrypt(const std::string& cipher_text);
+        std::string decrypt(const std::string& cipher_text) const;
+
+        /**
+         * @brief Шифрование фрагмента текста
+         * @param[in] open_text Открытый текст для шифрования
+         * @param[in] offset Количество букв текста, предшествующих фрагменту
+         * @return Зашифрованный текст
+         * @throw cipher_error при ошибках валидации
+         * @details Позволяет шифровать длинный текст по частям независимо
+         */
+        std::string encrypt(const std::string& open_text, size_t offset) const;
+
+        /**
+         * @brief Дешифрование фрагмента текста
+         * @param[in] cipher_text Зашифрованный текст
+         * @param[in] offset Количество букв текста, предшествующих фрагменту
+         * @return Расшифрованный текст
+         * @throw cipher_error при ошибках валидации
+         */
+        std::string decrypt(const std::string& cipher_text, size_t offset) const;
+
+        /**
+         * @brief Декодирование одного символа UTF-8 с проверкой
+         * @param[in] s Строка в UTF-8
+         * @param[in,out] pos Позиция первого байта символа; на выходе - следующего
+         * @return Кодовая точка символа
+         * @throw cipher_error при некорректной последовательности UTF-8
+         * @details Отвергаются обрывы последовательности, лишние байты
+         *          продолжения, избыточные формы и суррогаты
+         */
+        static char32_t decodeUtf8(std::string_view s, size_t& pos);
+
+        /**
+         * @brief Выделение русских букв текста
+         * @param[in] s Текст в UTF-8
+         * @param[in,out] out Буфер, в конец которого дописываются заглавные русские буквы в UTF-8
+         * @throw cipher_error при некорректной последовательности UTF-8
+         * @details Как и при шифровании, остаются только буквы А-я,
+         *          строчные переводятся в заглавные
+         */
+        static void russianLetters(std::string_view s, std::string& out);
 };
\ No newline at end of file
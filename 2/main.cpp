@@ -9,6 +9,8 @@
 #include "route.h"
 #include <string>
 
+using std::string;
+
 /**
  * @test Suite KeyTest
  * @brief Тесты для проверки ключа шифрования
@@ -22,4 +24,127 @@ SUITE(KeyTest) {
         code cipher(3, "PRIVET");
         CHECK_EQUAL("ITREPV", cipher.encryption("PRIVET"));
     }
-    
\ No newline at end of file
+}
+
+/**
+ * @test Suite RouteTest
+ * @brief Тесты для маршрутов чтения таблицы
+ */
+SUITE(RouteTest) {
+    /**
+     * @test SpiralRoute
+     * @brief Шифрование по спирали
+     */
+    TEST(SpiralRoute) {
+        code cipher(3, "ABCDEFGHI", route::spiralRoute());
+        CHECK_EQUAL("ABCFIHGDE", cipher.encryption("ABCDEFGHI"));
+    }
+
+    /**
+     * @test SnakeRoute
+     * @brief Шифрование змейкой
+     */
+    TEST(SnakeRoute) {
+        code cipher(3, "ABCDEFGHI", route::snakeRoute());
+        CHECK_EQUAL("CFIHEBADG", cipher.encryption("ABCDEFGHI"));
+    }
+
+    /**
+     * @test KeywordRoute
+     * @brief Шифрование по ключевому слову
+     */
+    TEST(KeywordRoute) {
+        code cipher(3, "ABCDEFGHI", route::byKeyword("CAB"));
+        CHECK_EQUAL("BEHCFIADG", cipher.encryption("ABCDEFGHI"));
+    }
+
+    /**
+     * @test KeywordLengthMismatch
+     * @brief Длина ключевого слова не равна ключу (ожидается исключение)
+     */
+    TEST(KeywordLengthMismatch) {
+        CHECK_THROW(code cp(3, "ABCDEFGHI", route::byKeyword("KEYS")), cipher_error);
+        CHECK_THROW(code cp(4, "ABCDEFGHI", route::byKeyword("KEY")), cipher_error);
+    }
+
+    /**
+     * @test RoundTrip
+     * @brief Дешифрование восстанавливает текст для всех маршрутов
+     */
+    TEST(RoundTrip) {
+        string text = "THEQUICKBROWNFOXJUMPS";
+        for (const route& r : {route::columns(), route::spiralRoute(),
+                               route::snakeRoute(), route::byKeyword("ZEBRA")}) {
+            code cipher(5, text, r);
+            CHECK_EQUAL(text, cipher.transcript(cipher.encryption(text), text));
+        }
+    }
+
+    /**
+     * @test PlanReuse
+     * @brief Один объект шифрует тексты с разным числом строк так же, как новые
+     */
+    TEST(PlanReuse) {
+        code cipher(4, "ABCDEFGH", route::spiralRoute());
+        for (string text : {"ABCDEFGHIJKLM", "ABCDEFGH", "ABCDEFGHIJKLMNOPQRST", "ABCDEFGHIJKLM"})
+            CHECK_EQUAL(code(4, text, route::spiralRoute()).encryption(text), cipher.encryption(text));
+    }
+}
+
+/**
+ * @test Suite Utf8Test
+ * @brief Тесты для перестановки символов UTF-8
+ */
+SUITE(Utf8Test) {
+    /**
+     * @test Cyrillic
+     * @brief Перестановка русских букв целиком
+     */
+    TEST(Cyrillic) {
+        code cipher(3, "ПРИВЕТ");
+        CHECK_EQUAL("ИТРЕПВ", cipher.encryptionUtf8("ПРИВЕТ"));
+        CHECK_EQUAL("ПРИВЕТ", cipher.transcriptUtf8("ИТРЕПВ", "ПРИВЕТ"));
+    }
+
+    /**
+     * @test Mixed
+     * @brief Перестановка латинских и русских букв вперемешку
+     */
+    TEST(Mixed) {
+        string text = "Съешь же ещё этих мягких french булок";
+        code cipher(4, text, route::spiralRoute());
+        string enc = cipher.encryptionUtf8(text);
+        CHECK(enc != "Съешьжеещёэтихмягкихfrenchбулок");
+        CHECK_EQUAL("Съешьжеещёэтихмягкихfrenchбулок", cipher.transcriptUtf8(enc, enc));
+    }
+
+    /**
+     * @test BadUtf8
+     * @brief Недопустимые символы и неверный UTF-8 (ожидается исключение)
+     */
+    TEST(BadUtf8) {
+        code cipher(3, "ПРИВЕТ");
+        CHECK_THROW(cipher.encryptionUtf8("ПРИВЕТ!"), cipher_error);
+        CHECK_THROW(cipher.encryptionUtf8("ПРИВЕ\xD0"), cipher_error);
+        CHECK_THROW(cipher.transcriptUtf8("ИТРЕП В", "ПРИВЕТ"), cipher_error);
+    }
+
+    /**
+     * @test KeyLongerThanLetters
+     * @brief Ключ больше числа букв, но не больше числа байт (ожидается исключение)
+     */
+    TEST(KeyLongerThanLetters) {
+        code cipher(8, "ПРИВЕТ");
+        CHECK_THROW(cipher.encryptionUtf8("ПРИВЕТ"), cipher_error);
+        CHECK_THROW(cipher.transcriptUtf8("ПРИВЕТ", "ПРИВЕТ"), cipher_error);
+    }
+}
+
+/**
+ * @brief Главная функция для запуска тестов
+ * @return Код завершения (0 - все тесты прошли успешно)
+ */
+int main()
+{
+    return UnitTest::RunAllTests();
+}
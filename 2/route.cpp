@@ -7,6 +7,295 @@
  */
 
 #include "route.h"
+#include <cstring>
+
+using namespace std;
+
+/**
+ * @brief Классический маршрут: столбцы справа налево
+ * @return Описание маршрута
+ */
+route route::columns() {
+    return route(columnsRightToLeft);
+}
+
+/**
+ * @brief Маршрут по спирали
+ * @return Описание маршрута
+ */
+route route::spiralRoute() {
+    return route(spiral);
+}
+
+/**
+ * @brief Маршрут змейкой
+ * @return Описание маршрута
+ */
+route route::snakeRoute() {
+    return route(snake);
+}
+
+/**
+ * @brief Маршрут по ключевому слову
+ * @param[in] word Ключевое слово (латинские буквы)
+ * @return Описание маршрута
+ * @throw cipher_error при пустом слове или не-буквенных символах
+ * @details Столбцы читаются сверху вниз в алфавитном порядке букв слова,
+ *          при совпадении букв - слева направо
+ */
+route route::byKeyword(const string& word) {
+    if (word.empty()) {
+        throw cipher_error("Пустое ключевое слово");
+    }
+    string w = word;
+    for (char& c : w) {
+        if ((c < 'A' || c > 'Z') && (c < 'a' || c > 'z')) {
+            throw cipher_error("Неверное ключевое слово: содержит не-буквенные символы");
+        }
+        c = toupper(c);
+    }
+
+    route r(keyword);
+    r.columnOrder.resize(w.size());
+    for (size_t j = 0; j < w.size(); j++)
+        r.columnOrder[j] = j;
+    stable_sort(r.columnOrder.begin(), r.columnOrder.end(), [&w](int a, int b) {
+        return w[a] < w[b];
+    });
+    return r;
+}
+
+/**
+ * @brief Проверка совместимости маршрута с числом столбцов
+ * @param[in] cols Количество столбцов
+ * @throw cipher_error если длина ключевого слова не равна числу столбцов
+ */
+void route::check(int cols) const {
+    if (k == keyword && (int)columnOrder.size() != cols) {
+        throw cipher_error("Длина ключевого слова не совпадает с ключом");
+    }
+}
+
+/**
+ * @brief Порядок обхода ячеек таблицы
+ * @param[in] rows Количество строк
+ * @param[in] cols Количество столбцов
+ * @return Номера ячеек (i * cols + j) в порядке чтения
+ */
+vector<int> route::order(int rows, int cols) const {
+    check(cols);
+    vector<int> cells;
+    cells.reserve(rows * cols);
+
+    switch (k) {
+    case columnsRightToLeft:
+        for (int j = cols - 1; j >= 0; j--)
+            for (int i = 0; i < rows; i++)
+                cells.push_back(i * cols + j);
+        break;
+
+    case snake:
+        for (int j = cols - 1; j >= 0; j--) {
+            if ((cols - 1 - j) % 2 == 0)
+                for (int i = 0; i < rows; i++)
+                    cells.push_back(i * cols + j);
+            else
+                for (int i = rows - 1; i >= 0; i--)
+                    cells.push_back(i * cols + j);
+        }
+        break;
+
+    case keyword:
+        for (int j : columnOrder)
+            for (int i = 0; i < rows; i++)
+                cells.push_back(i * cols + j);
+        break;
+
+    case spiral: {
+        int top = 0, bottom = rows - 1, left = 0, right = cols - 1;
+        while (top <= bottom && left <= right) {
+            for (int j = left; j <= right; j++)
+                cells.push_back(top * cols + j);
+            for (int i = top + 1; i <= bottom; i++)
+                cells.push_back(i * cols + right);
+            if (top < bottom)
+                for (int j = right - 1; j >= left; j--)
+                    cells.push_back(bottom * cols + j);
+            if (left < right)
+                for (int i = bottom - 1; i > top; i--)
+                    cells.push_back(i * cols + left);
+            top++;
+            bottom--;
+            left++;
+            right--;
+        }
+        break;
+    }
+    }
+    return cells;
+}
+
+/**
+ * @brief Компиляция маршрута
+ * @param[in] r Описание маршрута
+ * @param[in] rows Количество строк
+ * @param[in] cols Количество столбцов
+ * @details Соседние ячейки маршрута с одинаковой разностью номеров
+ *          объединяются в один отрезок
+ */
+routePlan::routePlan(const route& r, int rows, int cols): rows(rows), cols(cols) {
+    vector<int> cells = r.order(rows, cols);
+    int n = cells.size();
+    int i = 0;
+    while (i < n) {
+        run cur = {i, cells[i], 1, 1};
+        if (i + 1 < n) {
+            cur.stride = cells[i + 1] - cells[i];
+            while (i + cur.len < n && cells[i + cur.len] - cells[i + cur.len - 1] == cur.stride)
+                cur.len++;
+        }
+        runs.push_back(cur);
+        i += cur.len;
+    }
+}
+
+namespace {
+    /**
+     * @struct unit2
+     * @brief Двухбайтовый символ UTF-8 как неделимый элемент перестановки
+     */
+    struct unit2 {
+        char b[2]; ///< Байты символа
+    };
+}
+
+/**
+ * @brief Чтение по маршруту элементов типа T
+ * @param[in] src Элементы, записанные по строкам
+ * @param[out] dst Элементы в порядке маршрута
+ */
+template <typename T>
+void routePlan::gatherUnits(const T* src, T* dst) const {
+    for (const run& r : runs) {
+        T* out = dst + r.dst;
+        const T* in = src + r.src;
+        if (r.stride == 1) {
+            memcpy(out, in, r.len * sizeof(T));
+        } else {
+            for (int t = 0; t < r.len; t++)
+                out[t] = in[t * r.stride];
+        }
+    }
+}
+
+/**
+ * @brief Запись по маршруту элементов типа T
+ * @param[in] src Элементы в порядке маршрута
+ * @param[out] dst Элементы по строкам
+ */
+template <typename T>
+void routePlan::scatterUnits(const T* src, T* dst) const {
+    for (const run& r : runs) {
+        const T* in = src + r.dst;
+        T* out = dst + r.src;
+        if (r.stride == 1) {
+            memcpy(out, in, r.len * sizeof(T));
+        } else {
+            for (int t = 0; t < r.len; t++)
+                out[t * r.stride] = in[t];
+        }
+    }
+}
+
+/**
+ * @brief Чтение таблицы по маршруту (шифрование)
+ * @param[in] src Текст, записанный по строкам
+ * @param[out] dst Результат, не менее size() символов
+ */
+void routePlan::gather(const char* src, char* dst) const {
+    gatherUnits(src, dst);
+}
+
+/**
+ * @brief Запись по маршруту (дешифрование)
+ * @param[in] src Текст, прочитанный по маршруту
+ * @param[out] dst Результат по строкам, не менее size() символов
+ */
+void routePlan::scatter(const char* src, char* dst) const {
+    scatterUnits(src, dst);
+}
+
+/**
+ * @brief Чтение по маршруту символов по 2 байта (кириллица в UTF-8)
+ * @param[in] src Текст, записанный по строкам
+ * @param[out] dst Результат, не менее 2 * size() байт
+ */
+void routePlan::gather2(const char* src, char* dst) const {
+    gatherUnits(reinterpret_cast<const unit2*>(src), reinterpret_cast<unit2*>(dst));
+}
+
+/**
+ * @brief Запись по маршруту символов по 2 байта (кириллица в UTF-8)
+ * @param[in] src Текст, прочитанный по маршруту
+ * @param[out] dst Результат по строкам, не менее 2 * size() байт
+ */
+void routePlan::scatter2(const char* src, char* dst) const {
+    scatterUnits(reinterpret_cast<const unit2*>(src), reinterpret_cast<unit2*>(dst));
+}
+
+/**
+ * @brief Чтение по маршруту символов разной длины
+ * @param[in] src Текст, записанный по строкам
+ * @param[in] offsets Смещения начала каждого символа src и конца src
+ * @param[out] dst Результат, не менее offsets[size()] байт
+ * @return Количество записанных байт
+ * @details Символы результата идут подряд в порядке маршрута, поэтому
+ *          позиция записи - просто сумма длин уже записанных символов
+ */
+size_t routePlan::gatherVar(const char* src, const vector<uint32_t>& offsets, char* dst) const {
+    size_t pos = 0;
+    for (const run& r : runs) {
+        for (int t = 0; t < r.len; t++) {
+            int cell = r.src + t * r.stride;
+            size_t len = offsets[cell + 1] - offsets[cell];
+            memcpy(dst + pos, src + offsets[cell], len);
+            pos += len;
+        }
+    }
+    return pos;
+}
+
+/**
+ * @brief Запись по маршруту символов разной длины
+ * @param[in] src Текст, прочитанный по маршруту
+ * @param[in] offsets Смещения начала каждого символа src и конца src
+ * @param[out] dst Результат по строкам, не менее offsets[size()] байт
+ * @return Количество записанных байт
+ * @details Первый проход раскладывает длины символов по ячейкам таблицы
+ *          и превращает их в смещения ячеек в результате, второй - копирует
+ */
+size_t routePlan::scatterVar(const char* src, const vector<uint32_t>& offsets, char* dst) const {
+    vector<uint32_t> start(size() + 1, 0);
+    int i = 0;
+    for (const run& r : runs)
+        for (int t = 0; t < r.len; t++, i++)
+            start[r.src + t * r.stride] = offsets[i + 1] - offsets[i];
+
+    uint32_t pos = 0;
+    for (uint32_t& s : start) {
+        uint32_t len = s;
+        s = pos;
+        pos += len;
+    }
+
+    i = 0;
+    for (const run& r : runs)
+        for (int t = 0; t < r.len; t++, i++) {
+            int cell = r.src + t * r.stride;
+            memcpy(dst + start[cell], src + offsets[i], start[cell + 1] - start[cell]);
+        }
+    return pos;
+}
 
 /**
  * @brief Конструктор с ключом и текстом
@@ -14,8 +303,38 @@
  * @param[in] text Текст для инициализации
  * @details Проверяет валидность ключа относительно длины текста
  */
-code::code(int skey, string text) {
-    key = getValidKey(skey, text);
+code::code(int skey, string text): code(skey, text, route::columns()) {}
+
+/**
+ * @brief Конструктор с ключом, текстом и маршрутом
+ * @param[in] skey Ключ шифрования
+ * @param[in] text Текст для инициализации
+ * @param[in] r Маршрут чтения таблицы
+ * @throw cipher_error при невалидном ключе или несовместимом маршруте
+ * @details План компилируется для длины текста без пробелов
+ */
+code::code(int skey, string text, const route& r):
+    key(getValidKey(skey, text)),
+    path(r) {
+    planFor(text.size() - count(text.begin(), text.end(), ' '));
+}
+
+/**
+ * @brief План перестановки для текста заданной длины
+ * @param[in] length Длина текста
+ * @return План для числа строк текста (компилируется при первом обращении)
+ * @details Если сохранено maxPlans планов, кэш очищается, чтобы тексты
+ *          случайных длин не накапливали планы без ограничения
+ */
+const routePlan& code::planFor(int length) {
+    int rows = length / key;
+    auto it = plans.find(rows);
+    if (it == plans.end()) {
+        if (plans.size() >= maxPlans)
+            plans.clear();
+        it = plans.emplace(rows, routePlan(path, rows, key)).first;
+    }
+    return it->second;
 }
 
 /**
@@ -24,40 +343,14 @@ code::code(int skey, string text) {
  * @return Зашифрованный текст
  * @details Алгоритм:
  *          1. Запись текста в таблицу по строкам
- *          2. Чтение таблицы по столбцам справа налево
+ *          2. Чтение таблицы по маршруту
+ *          Символы, не поместившиеся в полные строки таблицы, остаются на месте
  */
 string code::encryption(const string& text) {
     string t = getValidOpenText(text);
-    int k = 0;
-    int simvoli = t.size();
-    int stroki = simvoli / key;
-    char** tabl = new char* [stroki];
-    for (int i = 0; i < stroki; i++)
-        tabl[i] = new char [key];
-
-    // Запись в таблицу по строкам
-    for (int i = 0; i < stroki; i++)
-        for (int j = 0; j < key; j++) {
-            if(k < simvoli) {
-                tabl[i][j] = t[k];
-                k++;
-            }
-        }
-
-    k = 0;
-    // Чтение из таблицы по столбцам справа налево
-    for (int j = key - 1; j >= 0 ; j--)
-        for (int i = 0; i < stroki; i++) {
-            t[k] = tabl[i][j];
-            k++;
-        }
-
-    // Освобождение памяти
-    for (int i = 0; i < stroki; i++)
-        delete[] tabl[i];
-    delete[] tabl;
-
-    return t;
+    string result = t;
+    planFor(t.size()).gather(t.data(), &result[0]);
+    return result;
 }
 
 /**
@@ -85,34 +378,108 @@ string code::transcript(const string& text, const string& open_text) {
     }
 
     string t = getValidCipherText(text, open_text);
-    int k = 0;
-    int simvoli = t.size();
-    int stroki = simvoli / key;
-    char** tabl = new char* [stroki];
-    for (int i = 0; i < stroki; i++)
-        tabl[i] = new char [key];
-
-    // Запись в таблицу по столбцам справа налево
-    for (int j = key - 1; j >= 0 ; j--)
-        for (int i = 0; i < stroki; i++) {
-            tabl[i][j] = t[k];
-            k++;
-        }
+    string result = t;
+    planFor(t.size()).scatter(t.data(), &result[0]);
+    return result;
+}
 
-    k = 0;
-    // Чтение из таблицы по строкам
-    for (int i = 0; i < stroki; i++)
-        for (int j = 0; j < key; j++) {
-            t[k] = tabl[i][j];
-            k++;
-        }
+/**
+ * @brief Шифрование текста в UTF-8 с перестановкой целых символов
+ * @param[in] text Текст из латинских и русских букв и пробелов
+ * @return Зашифрованный текст
+ * @throw cipher_error при невалидном тексте или ключе больше числа символов
+ * @details За один проход текст проверяется и размечается смещениями
+ *          символов, затем символы переставляются сразу в результат.
+ *          Если все символы одной длины (только латиница или только
+ *          кириллица), смещения не нужны и перестановка идет элементами
+ *          по 1 или 2 байта
+ */
+string code::encryptionUtf8(const string& text) {
+    vector<uint32_t> offsets;
+    string t = indexUtf8(text, true, offsets);
+    size_t n = offsets.size() - 1;
+    getValidKeyForLetters(n);
+    const routePlan& p = planFor(n);
+    string result = t;
+    if (t.size() == n)
+        p.gather(t.data(), &result[0]);
+    else if (t.size() == 2 * n)
+        p.gather2(t.data(), &result[0]);
+    else
+        p.gatherVar(t.data(), offsets, &result[0]);
+    return result;
+}
+
+/**
+ * @brief Дешифрование текста в UTF-8
+ * @param[in] text Зашифрованный текст
+ * @param[in] open_text Исходный открытый текст (для проверки длины)
+ * @return Расшифрованный текст
+ * @throw cipher_error при невалидном тексте, несоответствии длин или ключе больше числа символов
+ */
+string code::transcriptUtf8(const string& text, const string& open_text) {
+    vector<uint32_t> offsets, openOffsets;
+    string t = indexUtf8(text, false, offsets);
+    getValidCipherText(t, indexUtf8(open_text, false, openOffsets));
+    size_t n = offsets.size() - 1;
+    getValidKeyForLetters(n);
+    const routePlan& p = planFor(n);
+    string result = t;
+    if (t.size() == n)
+        p.scatter(t.data(), &result[0]);
+    else if (t.size() == 2 * n)
+        p.scatter2(t.data(), &result[0]);
+    else
+        p.scatterVar(t.data(), offsets, &result[0]);
+    return result;
+}
+
+/**
+ * @brief Проверка текста в UTF-8 и разметка символов
+ * @param[in] s Текст
+ * @param[in] allowSpaces Пробелы допустимы (и удаляются)
+ * @param[out] offsets Смещения начала каждого символа результата и его конца
+ * @return Текст без пробелов
+ * @throw cipher_error при пустом тексте, не-буквенных символах или неверном UTF-8
+ * @details Допустимы латинские буквы и русские буквы, включая Ё и ё
+ */
+string code::indexUtf8(const string& s, bool allowSpaces, vector<uint32_t>& offsets) {
+    string text;
+    text.reserve(s.size());
+    offsets.clear();
+    offsets.reserve(s.size() + 1);
 
-    // Освобождение памяти
-    for (int i = 0; i < stroki; i++)
-        delete[] tabl[i];
-    delete[] tabl;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(s.data());
+    size_t n = s.size();
+    for (size_t i = 0; i < n; ) {
+        unsigned char c = p[i];
+        if (c == ' ' && allowSpaces) {
+            i++;
+            continue;
+        }
+        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+            offsets.push_back(text.size());
+            text.push_back(c);
+            i++;
+            continue;
+        }
+        if ((c & 0xE0) == 0xC0 && i + 1 < n && (p[i + 1] & 0xC0) == 0x80) {
+            unsigned cp = ((c & 0x1F) << 6) | (p[i + 1] & 0x3F);
+            if ((cp >= 0x410 && cp <= 0x44F) || cp == 0x401 || cp == 0x451) {
+                offsets.push_back(text.size());
+                text.append(s, i, 2);
+                i += 2;
+                continue;
+            }
+        }
+        throw cipher_error("В тексте встречены некорректные символы!");
+    }
 
-    return t;
+    if (text.empty()) {
+        throw cipher_error("Отсутствует открытый текст!");
+    }
+    offsets.push_back(text.size());
+    return text;
 }
 
 /**
@@ -166,4 +533,18 @@ inline int code::getValidKey(int key, const string& Text) {
         throw cipher_error("Ключ некорректного размера");
     }
     return key;
+}
+
+/**
+ * @brief Проверка ключа по числу символов текста в UTF-8
+ * @param[in] letters Количество символов текста без пробелов
+ * @throw cipher_error если ключ меньше 2 или больше числа символов
+ * @details Конструктор сравнивает ключ с длиной текста в байтах, а у
+ *          кириллицы символ занимает 2 байта, поэтому методы для UTF-8
+ *          проверяют ключ заново
+ */
+void code::getValidKeyForLetters(size_t letters) const {
+    if (key < 2 || static_cast<size_t>(key) > letters) {
+        throw cipher_error("Ключ некорректного размера");
+    }
 }
\ No newline at end of file
@@ -7,41 +7,221 @@
 
 #pragma once
 #include <vector>
+#include <map>
 #include <string>
 #include <stdexcept>
 #include <algorithm>
-using namespace std;
+#include <cctype>
+#include <cstdint>
+#include "../common/cipher_error.h"
 
 /**
- * @class cipher_error
- * @brief Исключение для ошибок шифрования маршрутной перестановкой
+ * @class route
+ * @brief Описание маршрута чтения таблицы
+ * @details Текст всегда записывается в таблицу по строкам, маршрут задает
+ *          порядок обхода ячеек при чтении. Поддерживаются маршруты:
+ *          по столбцам справа налево, спираль, змейка и столбцы в порядке
+ *          букв ключевого слова
  */
-class cipher_error: public invalid_argument {
+class route {
     public:
         /**
-         * @brief Конструктор с строкой
-         * @param[in] what_arg Сообщение об ошибке
+         * @brief Вид маршрута
          */
-        explicit cipher_error (const string& what_arg):
-            invalid_argument(what_arg) {}
-            
+        enum kind {
+            columnsRightToLeft, ///< По столбцам справа налево (классический)
+            spiral,             ///< По спирали по часовой стрелке от левого верхнего угла
+            snake,              ///< Змейка по столбцам справа налево: вниз, вверх, вниз...
+            keyword             ///< По столбцам в алфавитном порядке букв ключевого слова
+        };
+
+        /**
+         * @brief Классический маршрут: столбцы справа налево
+         * @return Описание маршрута
+         */
+        static route columns();
+
+        /**
+         * @brief Маршрут по спирали
+         * @return Описание маршрута
+         */
+        static route spiralRoute();
+
+        /**
+         * @brief Маршрут змейкой
+         * @return Описание маршрута
+         */
+        static route snakeRoute();
+
+        /**
+         * @brief Маршрут по ключевому слову
+         * @param[in] word Ключевое слово (латинские буквы)
+         * @return Описание маршрута
+         * @throw cipher_error при пустом слове или не-буквенных символах
+         */
+        static route byKeyword(const std::string& word);
+
+        /**
+         * @brief Вид маршрута
+         * @return Вид маршрута
+         */
+        kind getKind() const { return k; }
+
+        /**
+         * @brief Проверка совместимости маршрута с числом столбцов
+         * @param[in] cols Количество столбцов
+         * @throw cipher_error если длина ключевого слова не равна числу столбцов
+         */
+        void check(int cols) const;
+
+        /**
+         * @brief Порядок обхода ячеек таблицы
+         * @param[in] rows Количество строк
+         * @param[in] cols Количество столбцов
+         * @return Номера ячеек (i * cols + j) в порядке чтения
+         */
+        std::vector<int> order(int rows, int cols) const;
+
+    private:
         /**
-         * @brief Конструктор с си-строкой
-         * @param[in] what_arg Сообщение об ошибке
+         * @brief Конструктор с видом маршрута
+         * @param[in] rk Вид маршрута
          */
-        explicit cipher_error (const char* what_arg):
-            invalid_argument(what_arg) {}
+        explicit route(kind rk): k(rk) {}
+
+        kind k; ///< Вид маршрута
+        std::vector<int> columnOrder; ///< Порядок столбцов для маршрута по ключевому слову
+};
+
+/**
+ * @class routePlan
+ * @brief Скомпилированный план перестановки для таблицы фиксированного размера
+ * @details При построении маршрут разбивается на отрезки с постоянным шагом.
+ *          Отрезки с шагом 1 копируются через memcpy, остальные - короткими
+ *          циклами выборки/записи с постоянным шагом без обращения к таблице
+ */
+class routePlan {
+    public:
+        /**
+         * @brief Компиляция маршрута
+         * @param[in] r Описание маршрута
+         * @param[in] rows Количество строк
+         * @param[in] cols Количество столбцов
+         */
+        routePlan(const route& r, int rows, int cols);
+
+        /**
+         * @brief Чтение таблицы по маршруту (шифрование)
+         * @param[in] src Текст, записанный по строкам
+         * @param[out] dst Результат, не менее size() символов
+         */
+        void gather(const char* src, char* dst) const;
+
+        /**
+         * @brief Запись по маршруту (дешифрование)
+         * @param[in] src Текст, прочитанный по маршруту
+         * @param[out] dst Результат по строкам, не менее size() символов
+         */
+        void scatter(const char* src, char* dst) const;
+
+        /**
+         * @brief Чтение по маршруту символов по 2 байта (кириллица в UTF-8)
+         * @param[in] src Текст, записанный по строкам
+         * @param[out] dst Результат, не менее 2 * size() байт
+         */
+        void gather2(const char* src, char* dst) const;
+
+        /**
+         * @brief Запись по маршруту символов по 2 байта (кириллица в UTF-8)
+         * @param[in] src Текст, прочитанный по маршруту
+         * @param[out] dst Результат по строкам, не менее 2 * size() байт
+         */
+        void scatter2(const char* src, char* dst) const;
+
+        /**
+         * @brief Чтение по маршруту символов разной длины
+         * @param[in] src Текст, записанный по строкам
+         * @param[in] offsets Смещения начала каждого символа src и конца src
+         * @param[out] dst Результат, не менее offsets[size()] байт
+         * @return Количество записанных байт
+         */
+        size_t gatherVar(const char* src, const std::vector<uint32_t>& offsets, char* dst) const;
+
+        /**
+         * @brief Запись по маршруту символов разной длины
+         * @param[in] src Текст, прочитанный по маршруту
+         * @param[in] offsets Смещения начала каждого символа src и конца src
+         * @param[out] dst Результат по строкам, не менее offsets[size()] байт
+         * @return Количество записанных байт
+         */
+        size_t scatterVar(const char* src, const std::vector<uint32_t>& offsets, char* dst) const;
+
+        /**
+         * @brief Количество строк таблицы
+         * @return Количество строк
+         */
+        int getRows() const { return rows; }
+
+        /**
+         * @brief Количество переставляемых символов
+         * @return rows * cols
+         */
+        int size() const { return rows * cols; }
+
+    private:
+        /**
+         * @struct run
+         * @brief Отрезок маршрута с постоянным шагом
+         */
+        struct run {
+            int dst;    ///< Начало в тексте, прочитанном по маршруту
+            int src;    ///< Начало в таблице
+            int len;    ///< Длина отрезка
+            int stride; ///< Шаг по таблице
+        };
+
+        /**
+         * @brief Чтение по маршруту элементов типа T
+         * @param[in] src Элементы, записанные по строкам
+         * @param[out] dst Элементы в порядке маршрута
+         */
+        template <typename T> void gatherUnits(const T* src, T* dst) const;
+
+        /**
+         * @brief Запись по маршруту элементов типа T
+         * @param[in] src Элементы в порядке маршрута
+         * @param[out] dst Элементы по строкам
+         */
+        template <typename T> void scatterUnits(const T* src, T* dst) const;
+
+        int rows; ///< Количество строк
+        int cols; ///< Количество столбцов
+        std::vector<run> runs; ///< Отрезки маршрута
 };
 
 /**
  * @class code
  * @brief Класс для шифрования методом маршрутной перестановки
  * @details Шифрование происходит путем записи текста в таблицу по строкам
- *          и чтения по столбцам в обратном порядке
+ *          и чтения по заданному маршруту (по умолчанию - по столбцам
+ *          в обратном порядке). Маршрут компилируется в routePlan
+ *          при создании объекта; планы для других чисел строк компилируются
+ *          при первом обращении и сохраняются (не более maxPlans)
  */
 class code {
     private:
         int key; ///< Ключ шифрования (количество столбцов)
+        route path = route::columns(); ///< Маршрут чтения таблицы
+        std::map<int, routePlan> plans; ///< Скомпилированные планы по числу строк
+
+        static const size_t maxPlans = 256; ///< Наибольшее число хранимых планов
+
+        /**
+         * @brief План перестановки для текста заданной длины
+         * @param[in] length Длина текста
+         * @return План для числа строк текста (компилируется при первом обращении)
+         */
+        const routePlan& planFor(int length);
         
         /**
          * @brief Проверка валидности ключа
@@ -50,7 +230,14 @@ class code {
          * @return Валидный ключ
          * @throw cipher_error при невалидном ключе
          */
-        inline int getValidKey(int key, const string& Text);
+        inline int getValidKey(int key, const std::string& Text);
+
+        /**
+         * @brief Проверка ключа по числу символов текста в UTF-8
+         * @param[in] letters Количество символов текста без пробелов
+         * @throw cipher_error если ключ меньше 2 или больше числа символов
+         */
+        void getValidKeyForLetters(size_t letters) const;
         
         /**
          * @brief Проверка валидности открытого текста
@@ -58,7 +245,7 @@ class code {
          * @return Валидированный текст
          * @throw cipher_error при невалидном тексте
          */
-        inline string getValidOpenText(const string& s);
+        inline std::string getValidOpenText(const std::string& s);
         
         /**
          * @brief Проверка валидности зашифрованного текста
@@ -67,7 +254,17 @@ class code {
          * @return Валидированный зашифрованный текст
          * @throw cipher_error при несоответствии длин
          */
-        inline string getValidCipherText(const string& s, const string& open_text);
+        inline std::string getValidCipherText(const std::string& s, const std::string& open_text);
+
+        /**
+         * @brief Проверка текста в UTF-8 и разметка символов
+         * @param[in] s Текст
+         * @param[in] allowSpaces Пробелы допустимы (и удаляются)
+         * @param[out] offsets Смещения начала каждого символа результата и его конца
+         * @return Текст без пробелов
+         * @throw cipher_error при пустом тексте, не-буквенных символах или неверном UTF-8
+         */
+        static std::string indexUtf8(const std::string& s, bool allowSpaces, std::vector<uint32_t>& offsets);
         
     public:
         /**
@@ -80,14 +277,23 @@ class code {
          * @param[in] skey Ключ шифрования
          * @param[in] text Текст для инициализации
          */
-        code(int skey, string text);
+        code(int skey, std::string text);
+
+        /**
+         * @brief Конструктор с ключом, текстом и маршрутом
+         * @param[in] skey Ключ шифрования
+         * @param[in] text Текст для инициализации
+         * @param[in] r Маршрут чтения таблицы
+         * @throw cipher_error при невалидном ключе или несовместимом маршруте
+         */
+        code(int skey, std::string text, const route& r);
         
         /**
          * @brief Шифрование текста
          * @param[in] text Текст для шифрования
          * @return Зашифрованный текст
          */
-        string encryption(const string& text);
+        std::string encryption(const std::string& text);
         
         /**
          * @brief Дешифрование текста
@@ -95,5 +301,22 @@ class code {
          * @param[in] open_text Исходный открытый текст (для проверки длины)
          * @return Расшифрованный текст
          */
-        string transcript(const string& text, const string& open_text);
+        std::string transcript(const std::string& text, const std::string& open_text);
+
+        /**
+         * @brief Шифрование текста в UTF-8 с перестановкой целых символов
+         * @param[in] text Текст из латинских и русских букв и пробелов
+         * @return Зашифрованный текст
+         * @throw cipher_error при невалидном тексте или ключе больше числа символов
+         */
+        std::string encryptionUtf8(const std::string& text);
+
+        /**
+         * @brief Дешифрование текста в UTF-8
+         * @param[in] text Зашифрованный текст
+         * @param[in] open_text Исходный открытый текст (для проверки длины)
+         * @return Расшифрованный текст
+         * @throw cipher_error при невалидном тексте, несоответствии длин или ключе больше числа символов
+         */
+        std::string transcriptUtf8(const std::string& text, const std::string& open_text);
 };
\ No newline at end of file
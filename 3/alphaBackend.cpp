@@ -0,0 +1,93 @@
+/**
+ * @file alphaBackend.cpp
+ * @brief Обработчик файлов для шифра modAlphaCipher
+ * @author Назарова Софья
+ * @date 2025
+ * @copyright WECT ПГУ
+ */
+
+#include "cipherBackend.h"
+#include "../1/modAlphaCipher.h"
+#include <cctype>
+
+namespace {
+
+/**
+ * @class alphaBackend
+ * @brief Обработчик для шифра modAlphaCipher
+ * @details Нормализованный текст состоит из заглавных русских букв,
+ *          каждая занимает в UTF-8 ровно 2 байта, поэтому номер буквы
+ *          равен смещению в байтах, деленному на 2
+ */
+class alphaBackend: public cipherBackend {
+    public:
+        /**
+         * @brief Конструктор с ключом
+         * @param[in] key Ключ шифрования
+         */
+        explicit alphaBackend(const std::string& key): cipher(key) {}
+
+        void normalize(std::string_view raw, bool encrypting, std::string& out) const override;
+
+        size_t unit() const override { return 2; }
+
+        void transform(std::string_view part, size_t offset, bool encrypting,
+                       std::string& out) const override;
+
+    private:
+        modAlphaCipher cipher; ///< Шифр (общий для потоков пула)
+};
+
+/**
+ * @brief Нормализация содержимого файла
+ * @param[in] raw Содержимое файла
+ * @param[in] encrypting true - для шифрования, false - для дешифрования
+ * @param[in,out] out Буфер, в конец которого дописываются буквы в UTF-8
+ * @details При шифровании, как и в modAlphaCipher, отбрасывается все,
+ *          кроме букв А-я, строчные буквы переводятся в заглавные.
+ *          При дешифровании отбрасываются только пробельные символы,
+ *          остальное проверяет шифр
+ * @throw cipher_error при некорректной последовательности UTF-8
+ */
+void alphaBackend::normalize(std::string_view raw, bool encrypting, std::string& out) const {
+    if (encrypting) {
+        modAlphaCipher::russianLetters(raw, out);
+        return;
+    }
+    out.reserve(out.size() + raw.size());
+    for (size_t i = 0; i < raw.size(); ) {
+        size_t start = i;
+        char32_t cp = modAlphaCipher::decodeUtf8(raw, i);
+        if (cp >= 0x80 || !isspace(cp))
+            out.append(raw, start, i - start);
+    }
+}
+
+/**
+ * @brief Преобразование части нормализованного текста
+ * @param[in] part Часть текста
+ * @param[in] offset Смещение части в байтах нормализованного текста
+ * @param[in] encrypting true - шифрование, false - дешифрование
+ * @param[out] out Результат той же длины, что и part
+ * @details modAlphaCipher возвращает новую строку; она копируется в out,
+ *          чтобы буфер вызывающей стороны сохранил свою память
+ */
+void alphaBackend::transform(std::string_view part, size_t offset, bool encrypting,
+                             std::string& out) const {
+    out.clear();
+    if (part.empty())
+        return;
+    std::string text(part);
+    out.append(encrypting ? cipher.encrypt(text, offset / 2) : cipher.decrypt(text, offset / 2));
+}
+
+}
+
+/**
+ * @brief Создание обработчика для шифра modAlphaCipher
+ * @param[in] key Ключ шифрования
+ * @return Обработчик
+ */
+std::unique_ptr<cipherBackend> makeAlphaBackend(const std::string& key) {
+    return std::unique_ptr<cipherBackend>(new alphaBackend(key));
+}
@@ -0,0 +1,97 @@
+/**
+ * @file cipherBackend.h
+ * @brief Общий интерфейс шифров для обработки файлов
+ * @author Назарова Софья
+ * @date 2025
+ */
+
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @class cipherBackend
+ * @brief Шифр, применяемый к содержимому файла по частям
+ * @details Содержимое файла сначала нормализуется (остаются только буквы,
+ *          допустимые для шифра), затем нормализованный текст делится на
+ *          части, кратные unit() байтам, и каждая часть преобразуется
+ *          независимо с учетом своего смещения. Результат совпадает
+ *          с преобразованием всего текста целиком. Результаты пишутся
+ *          в буфер вызывающей стороны, что позволяет повторно использовать
+ *          его память для очередных частей
+ */
+class cipherBackend {
+    public:
+        virtual ~cipherBackend() = default;
+
+        /**
+         * @brief Нормализация содержимого файла
+         * @param[in] raw Содержимое файла (только полные символы UTF-8)
+         * @param[in] encrypting true - для шифрования, false - для дешифрования
+         * @param[in,out] out Буфер, в конец которого дописывается текст, пригодный для transform()
+         * @throw std::invalid_argument при некорректном содержимом
+         */
+        virtual void normalize(std::string_view raw, bool encrypting, std::string& out) const = 0;
+
+        /**
+         * @brief Нормализация содержимого файла в новую строку
+         * @param[in] raw Содержимое файла
+         * @param[in] encrypting true - для шифрования, false - для дешифрования
+         * @return Текст, пригодный для transform()
+         */
+        std::string normalize(std::string_view raw, bool encrypting) const {
+            std::string out;
+            normalize(raw, encrypting, out);
+            return out;
+        }
+
+        /**
+         * @brief Кратность границ частей в байтах нормализованного текста
+         * @return Размер неделимой единицы
+         */
+        virtual size_t unit() const = 0;
+
+        /**
+         * @brief Преобразование части нормализованного текста
+         * @param[in] part Часть текста
+         * @param[in] offset Смещение части в байтах нормализованного текста
+         * @param[in] encrypting true - шифрование, false - дешифрование
+         * @param[out] out Результат той же длины, что и part (прежнее содержимое
+         *                 заменяется, выделенная память сохраняется)
+         * @throw std::invalid_argument при ошибках шифра
+         */
+        virtual void transform(std::string_view part, size_t offset, bool encrypting,
+                               std::string& out) const = 0;
+
+        /**
+         * @brief Преобразование части нормализованного текста в новую строку
+         * @param[in] part Часть текста
+         * @param[in] offset Смещение части в байтах нормализованного текста
+         * @param[in] encrypting true - шифрование, false - дешифрование
+         * @return Результат той же длины, что и part
+         * @throw std::invalid_argument при ошибках шифра
+         */
+        std::string transform(std::string_view part, size_t offset, bool encrypting) const {
+            std::string out;
+            transform(part, offset, encrypting, out);
+            return out;
+        }
+};
+
+/**
+ * @brief Создание обработчика для шифра modAlphaCipher
+ * @param[in] key Ключ шифрования
+ * @return Обработчик
+ * @throw std::invalid_argument при невалидном ключе
+ */
+std::unique_ptr<cipherBackend> makeAlphaBackend(const std::string& key);
+
+/**
+ * @brief Создание обработчика для шифра маршрутной перестановки
+ * @param[in] key Количество столбцов таблицы
+ * @param[in] block Размер независимо переставляемого блока в буквах
+ * @return Обработчик
+ * @throw std::invalid_argument при невалидном ключе или размере блока
+ */
+std::unique_ptr<cipherBackend> makeRouteBackend(int key, size_t block);
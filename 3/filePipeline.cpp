@@ -0,0 +1,621 @@
+/**
+ * @file filePipeline.cpp
+ * @brief Реализация конвейера чтение - шифрование - запись
+ * @author Назарова Софья
+ * @date 2025
+ * @copyright WECT ПГУ
+ */
+
+#include "filePipeline.h"
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Исключение по коду ошибки errno
+ * @param[in] code Код ошибки
+ * @param[in] what Описание операции
+ * @return Исключение для throw
+ */
+std::system_error ioError(int code, const char* what) {
+    return std::system_error(code, std::generic_category(), what);
+}
+
+/**
+ * @brief Длина незавершенной последовательности UTF-8 в конце строки
+ * @param[in] s Строка
+ * @return Количество байт, которые нужно отложить до следующей части
+ */
+size_t incompleteTail(const std::string& s) {
+    size_t n = s.size();
+    for (size_t k = 1; k <= 3 && k <= n; k++) {
+        unsigned char c = s[n - k];
+        if ((c & 0xC0) == 0x80)
+            continue;
+        if (c < 0xC0)
+            return 0;
+        size_t need = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : 2;
+        return need > k ? k : 0;
+    }
+    return 0;
+}
+
+/**
+ * @class uring
+ * @brief Минимальная обертка над системными вызовами io_uring
+ * @details Кольца отображаются одним mmap (IORING_FEAT_SINGLE_MMAP),
+ *          используются операции IORING_OP_READ и IORING_OP_WRITE
+ */
+class uring {
+    public:
+        uring() = default;
+        uring(const uring&) = delete;
+        uring& operator=(const uring&) = delete;
+
+        /**
+         * @brief Закрытие кольца
+         */
+        ~uring() {
+            if (sqes != MAP_FAILED)
+                munmap(sqes, sqesSize);
+            if (ring != MAP_FAILED)
+                munmap(ring, ringSize);
+            if (fd >= 0)
+                close(fd);
+        }
+
+        /**
+         * @brief Создание кольца
+         * @param[in] entries Размер очереди
+         * @return false, если ядро не поддерживает нужные возможности
+         */
+        bool open(unsigned entries) {
+            io_uring_params p;
+            memset(&p, 0, sizeof(p));
+            fd = syscall(__NR_io_uring_setup, entries, &p);
+            if (fd < 0)
+                return false;
+            // IORING_FEAT_RW_CUR_POS появился вместе с IORING_OP_READ/WRITE (Linux 5.6)
+            if (!(p.features & IORING_FEAT_SINGLE_MMAP) || !(p.features & IORING_FEAT_RW_CUR_POS))
+                return false;
+
+            ringSize = std::max(p.sq_off.array + p.sq_entries * sizeof(unsigned),
+                                p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe));
+            ring = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        fd, IORING_OFF_SQ_RING);
+            if (ring == MAP_FAILED)
+                return false;
+            sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+            void* s = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           fd, IORING_OFF_SQES);
+            if (s == MAP_FAILED)
+                return false;
+            sqes = s;
+
+            char* base = static_cast<char*>(ring);
+            sqTail = reinterpret_cast<unsigned*>(base + p.sq_off.tail);
+            sqMask = *reinterpret_cast<unsigned*>(base + p.sq_off.ring_mask);
+            sqArray = reinterpret_cast<unsigned*>(base + p.sq_off.array);
+            cqHead = reinterpret_cast<unsigned*>(base + p.cq_off.head);
+            cqTail = reinterpret_cast<unsigned*>(base + p.cq_off.tail);
+            cqMask = *reinterpret_cast<unsigned*>(base + p.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(base + p.cq_off.cqes);
+            tail = *sqTail;
+            return true;
+        }
+
+        /**
+         * @brief Постановка операции чтения или записи
+         * @param[in] op IORING_OP_READ или IORING_OP_WRITE
+         * @param[in] file Дескриптор файла
+         * @param[in] buf Буфер
+         * @param[in] len Длина
+         * @param[in] offset Смещение в файле
+         * @param[in] tag Метка для результата
+         */
+        void prepare(int op, int file, const void* buf, size_t len, off_t offset, uint64_t tag) {
+            unsigned index = tail & sqMask;
+            io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes) + index;
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = op;
+            sqe->fd = file;
+            sqe->addr = reinterpret_cast<uint64_t>(buf);
+            sqe->len = len;
+            sqe->off = offset;
+            sqe->user_data = tag;
+            sqArray[index] = index;
+            tail++;
+            toSubmit++;
+        }
+
+        /**
+         * @brief Отправка поставленных операций и ожидание хотя бы одного результата
+         * @throw std::system_error при ошибке io_uring_enter
+         */
+        void submitAndWait() {
+            __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+            for (;;) {
+                int r = syscall(__NR_io_uring_enter, fd, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                if (r >= 0) {
+                    toSubmit -= r;
+                    return;
+                }
+                if (errno != EINTR)
+                    throw ioError(errno, "io_uring_enter");
+            }
+        }
+
+        /**
+         * @brief Извлечение готового результата
+         * @param[out] cqe Результат
+         * @return false, если готовых результатов нет
+         */
+        bool pop(io_uring_cqe& cqe) {
+            unsigned head = *cqHead;
+            if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+                return false;
+            cqe = cqes[head & cqMask];
+            __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+    private:
+        int fd = -1; ///< Дескриптор кольца
+        void* ring = MAP_FAILED; ///< Отображение колец SQ и CQ
+        size_t ringSize = 0; ///< Размер отображения колец
+        void* sqes = MAP_FAILED; ///< Отображение массива SQE
+        size_t sqesSize = 0; ///< Размер массива SQE
+        unsigned* sqTail = nullptr; ///< Хвост очереди отправки
+        unsigned sqMask = 0; ///< Маска очереди отправки
+        unsigned* sqArray = nullptr; ///< Индексы SQE
+        unsigned* cqHead = nullptr; ///< Голова очереди результатов
+        unsigned* cqTail = nullptr; ///< Хвост очереди результатов
+        unsigned cqMask = 0; ///< Маска очереди результатов
+        io_uring_cqe* cqes = nullptr; ///< Результаты
+        unsigned tail = 0; ///< Локальный хвост очереди отправки
+        unsigned toSubmit = 0; ///< Поставленные, но не отправленные операции
+};
+
+/**
+ * @class indexQueue
+ * @brief Блокирующая очередь номеров буферов для потоков конвейера
+ */
+class indexQueue {
+    public:
+        /**
+         * @brief Добавление элемента
+         * @param[in] index Номер буфера
+         * @param[in] size Размер данных
+         */
+        void push(unsigned index, size_t size) {
+            {
+                std::lock_guard<std::mutex> g(lock);
+                items.push_back({index, size});
+            }
+            ready.notify_one();
+        }
+
+        /**
+         * @brief Извлечение элемента с ожиданием
+         * @param[out] index Номер буфера
+         * @param[out] size Размер данных
+         * @return false, если очередь закрыта
+         */
+        bool pop(unsigned& index, size_t& size) {
+            std::unique_lock<std::mutex> g(lock);
+            ready.wait(g, [this] { return closed || !items.empty(); });
+            if (closed)
+                return false;
+            index = items.front().first;
+            size = items.front().second;
+            items.pop_front();
+            return true;
+        }
+
+        /**
+         * @brief Закрытие очереди: все ожидающие pop() возвращают false
+         */
+        void close() {
+            {
+                std::lock_guard<std::mutex> g(lock);
+                closed = true;
+            }
+            ready.notify_all();
+        }
+
+    private:
+        std::mutex lock; ///< Защита очереди
+        std::condition_variable ready; ///< Сигнал о новом элементе
+        std::deque<std::pair<unsigned, size_t>> items; ///< Номера буферов и размеры данных
+        bool closed = false; ///< Признак закрытия
+};
+
+/**
+ * @brief Запись всего буфера с повтором при неполной записи
+ * @param[in] fd Дескриптор файла
+ * @param[in] data Данные
+ * @param[in] size Размер данных
+ * @param[in] offset Смещение в файле
+ * @throw std::system_error при ошибке записи
+ */
+void writeAll(int fd, const char* data, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t r = pwrite(fd, data, size, offset);
+        if (r < 0) {
+            if (errno == EINTR)
+                continue;
+            throw ioError(errno, "write");
+        }
+        data += r;
+        size -= r;
+        offset += r;
+    }
+}
+
+/**
+ * @class fileHandle
+ * @brief Дескриптор файла, закрываемый в деструкторе
+ */
+class fileHandle {
+    public:
+        /**
+         * @brief Конструктор с дескриптором
+         * @param[in] fd Дескриптор файла
+         */
+        explicit fileHandle(int fd): fd(fd) {}
+        ~fileHandle() { if (fd >= 0) close(fd); }
+        fileHandle(const fileHandle&) = delete;
+        fileHandle& operator=(const fileHandle&) = delete;
+        int fd; ///< Дескриптор файла
+};
+
+}
+
+/**
+ * @brief Конструктор с шифром
+ * @param[in] backend Шифр
+ * @param[in] encrypting true - шифрование, false - дешифрование
+ */
+streamTransform::streamTransform(const cipherBackend& backend, bool encrypting):
+    backend(backend), encrypting(encrypting) {}
+
+/**
+ * @brief Обработка очередной части исходных данных
+ * @param[in] data Данные
+ * @param[in] size Размер данных
+ * @param[out] out Результат для всех полных единиц
+ */
+void streamTransform::feed(const char* data, size_t size, std::string& out) {
+    raw.append(data, size);
+    size_t keep = incompleteTail(raw);
+    backend.normalize(std::string_view(raw).substr(0, raw.size() - keep), encrypting, pending);
+    raw.erase(0, raw.size() - keep);
+
+    size_t n = pending.size() / backend.unit() * backend.unit();
+    out.clear();
+    if (n > 0) {
+        backend.transform(std::string_view(pending).substr(0, n), offset, encrypting, out);
+        pending.erase(0, n);
+        offset += n;
+    }
+}
+
+/**
+ * @brief Обработка остатка после последней части
+ * @param[out] out Результат
+ */
+void streamTransform::finish(std::string& out) {
+    backend.normalize(raw, encrypting, pending);
+    raw.clear();
+    out.clear();
+    if (!pending.empty()) {
+        backend.transform(pending, offset, encrypting, out);
+        offset += pending.size();
+        pending.clear();
+    }
+}
+
+/**
+ * @brief Конструктор с шифром и параметрами
+ * @param[in] backend Шифр
+ * @param[in] encrypting true - шифрование, false - дешифрование
+ * @param[in] options Параметры конвейера
+ */
+filePipeline::filePipeline(const cipherBackend& backend, bool encrypting,
+                           const pipelineOptions& options):
+    backend(backend), encrypting(encrypting), options(options) {
+    if (this->options.buffers < 2)
+        this->options.buffers = 2;
+    if (this->options.bufferSize == 0)
+        this->options.bufferSize = 1 << 20;
+}
+
+/**
+ * @brief Обработка файла
+ * @param[in] src Исходный файл
+ * @param[in] dst Файл результата (каталоги создаются)
+ * @details Результат пишется во временный файл рядом с dst, который
+ *          заменяет dst только после успешной обработки. Поэтому dst
+ *          может совпадать с src: исходный файл не обрезается до чтения,
+ *          а при ошибке остается нетронутым
+ */
+void filePipeline::process(const std::filesystem::path& src, const std::filesystem::path& dst) {
+    static std::atomic<unsigned> counter{0};
+
+    fileHandle in(open(src.c_str(), O_RDONLY | O_CLOEXEC));
+    if (in.fd < 0)
+        throw ioError(errno, "open");
+    std::filesystem::create_directories(dst.parent_path());
+    std::filesystem::path tmp = dst;
+    tmp += ".lb3tmp." + std::to_string(getpid()) + "." + std::to_string(counter++);
+    fileHandle out(open(tmp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644));
+    if (out.fd < 0)
+        throw ioError(errno, "open");
+
+    try {
+        uringUsed = options.useUring && processUring(in.fd, out.fd);
+        if (!uringUsed)
+            processThreads(in.fd, out.fd);
+        if (rename(tmp.c_str(), dst.c_str()) < 0)
+            throw ioError(errno, "rename");
+    } catch (...) {
+        unlink(tmp.c_str());
+        throw;
+    }
+}
+
+/**
+ * @brief Обработка через io_uring
+ * @param[in] in Дескриптор исходного файла
+ * @param[in] out Дескриптор файла результата
+ * @return false, если io_uring недоступен и ничего не было сделано
+ * @details Буфер чтения с номером seq % buffers принимает seq-й блок файла.
+ *          Блоки шифруются строго по порядку, как только готов очередной;
+ *          буфер чтения сразу отдается под следующий блок, а результат
+ *          уходит на запись из свободного буфера записи
+ */
+bool filePipeline::processUring(int in, int out) {
+    struct stat st;
+    if (fstat(in, &st) < 0)
+        throw ioError(errno, "fstat");
+
+    const unsigned n = options.buffers;
+    uring ring;
+    if (!ring.open(2 * n))
+        return false;
+
+    /**
+     * @struct slot
+     * @brief Буфер пула с состоянием операции
+     */
+    struct slot {
+        std::string data; ///< Данные
+        off_t offset = 0; ///< Смещение в файле
+        size_t len = 0; ///< Длина операции
+        size_t done = 0; ///< Выполнено байт
+        bool busy = false; ///< Буфер занят
+    };
+    std::vector<slot> reads(n), writes(n);
+    for (slot& s : reads)
+        s.data.resize(options.bufferSize);
+
+    const uint64_t writeTag = 1ull << 32;
+    const off_t size = st.st_size;
+    off_t readOffset = 0, writeOffset = 0;
+    size_t scheduled = 0, processed = 0;
+    unsigned inFlight = 0;
+
+    /**
+     * @struct drainGuard
+     * @brief Ожидание всех операций кольца перед освобождением буферов
+     * @details Объявлен после буферов и уничтожается раньше них, в том числе
+     *          при исключении, чтобы ядро не писало в освобожденную память.
+     *          Чтение и запись обычных файлов всегда завершаются, поэтому
+     *          отменять их не нужно - достаточно дождаться результатов
+     */
+    struct drainGuard {
+        uring& ring; ///< Кольцо
+        unsigned& inFlight; ///< Операции в работе
+        ~drainGuard() {
+            io_uring_cqe cqe;
+            while (inFlight > 0) {
+                try {
+                    ring.submitAndWait();
+                } catch (const std::system_error&) {
+                    return;
+                }
+                while (ring.pop(cqe))
+                    inFlight--;
+            }
+        }
+    } drain{ring, inFlight};
+
+    streamTransform transform(backend, encrypting);
+
+    auto submitWrite = [&](unsigned w) {
+        slot& s = writes[w];
+        ring.prepare(IORING_OP_WRITE, out, s.data.data() + s.done, s.len - s.done,
+                     s.offset + s.done, writeTag | w);
+        inFlight++;
+    };
+
+    auto scheduleReads = [&] {
+        while (scheduled < processed + n && readOffset < size) {
+            slot& s = reads[scheduled % n];
+            s.offset = readOffset;
+            s.len = std::min<off_t>(options.bufferSize, size - readOffset);
+            s.done = 0;
+            s.busy = true;
+            ring.prepare(IORING_OP_READ, in, &s.data[0], s.len, s.offset, scheduled % n);
+            inFlight++;
+            readOffset += s.len;
+            scheduled++;
+        }
+    };
+
+    for (;;) {
+        scheduleReads();
+        while (processed < scheduled && !reads[processed % n].busy) {
+            unsigned w = 0;
+            while (w < n && writes[w].busy)
+                w++;
+            if (w == n)
+                break;
+            slot& r = reads[processed % n];
+            transform.feed(r.data.data(), r.done, writes[w].data);
+            processed++;
+            scheduleReads();
+            if (!writes[w].data.empty()) {
+                writes[w].offset = writeOffset;
+                writes[w].len = writes[w].data.size();
+                writes[w].done = 0;
+                writes[w].busy = true;
+                writeOffset += writes[w].len;
+                submitWrite(w);
+            }
+        }
+
+        if (inFlight == 0)
+            break;
+
+        ring.submitAndWait();
+        io_uring_cqe cqe;
+        while (ring.pop(cqe)) {
+            inFlight--;
+            bool isWrite = cqe.user_data & writeTag;
+            slot& s = (isWrite ? writes : reads)[cqe.user_data & 0xFFFFFFFF];
+            if (cqe.res < 0)
+                throw ioError(-cqe.res, isWrite ? "write" : "read");
+            if (cqe.res == 0 && !isWrite) {
+                // Файл укоротился во время чтения
+                s.len = s.done;
+            }
+            s.done += cqe.res;
+            if (s.done < s.len) {
+                if (isWrite)
+                    submitWrite(cqe.user_data & 0xFFFFFFFF);
+                else {
+                    ring.prepare(IORING_OP_READ, in, &s.data[s.done], s.len - s.done,
+                                 s.offset + s.done, cqe.user_data);
+                    inFlight++;
+                }
+            } else {
+                s.busy = false;
+            }
+        }
+    }
+
+    std::string tail;
+    transform.finish(tail);
+    writeAll(out, tail.data(), tail.size(), writeOffset);
+    return true;
+}
+
+/**
+ * @brief Обработка потоками чтения и записи
+ * @param[in] in Дескриптор исходного файла
+ * @param[in] out Дескриптор файла результата
+ * @details Поток чтения заполняет свободные буферы чтения, вызывающий
+ *          поток шифрует, поток записи пишет результаты и возвращает
+ *          буферы записи в пул. Конец файла обозначается блоком длины 0
+ */
+void filePipeline::processThreads(int in, int out) {
+    const unsigned n = options.buffers;
+    std::vector<std::string> reads(n), writes(n);
+    for (std::string& s : reads)
+        s.resize(options.bufferSize);
+    indexQueue freeReads, fullReads, freeWrites, fullWrites;
+    for (unsigned i = 0; i < n; i++) {
+        freeReads.push(i, 0);
+        freeWrites.push(i, 0);
+    }
+
+    int readError = 0, writeError = 0;
+    std::thread reader([&] {
+        unsigned i;
+        size_t unused;
+        while (freeReads.pop(i, unused)) {
+            size_t len = 0;
+            while (len < reads[i].size()) {
+                ssize_t r = read(in, &reads[i][len], reads[i].size() - len);
+                if (r < 0 && errno == EINTR)
+                    continue;
+                if (r < 0)
+                    readError = errno;
+                if (r <= 0)
+                    break;
+                len += r;
+            }
+            fullReads.push(i, readError ? 0 : len);
+            if (len == 0 || readError)
+                return;
+        }
+    });
+    std::thread writer([&] {
+        unsigned i;
+        size_t len;
+        off_t offset = 0;
+        while (fullWrites.pop(i, len) && i < n) {
+            try {
+                writeAll(out, writes[i].data(), len, offset);
+            } catch (const std::system_error& e) {
+                writeError = e.code().value();
+                freeWrites.close();
+                return;
+            }
+            offset += len;
+            freeWrites.push(i, 0);
+        }
+    });
+
+    try {
+        streamTransform transform(backend, encrypting);
+        unsigned r = 0, w = 0;
+        size_t len = 0, unused = 0;
+        for (;;) {
+            if (!fullReads.pop(r, len) || !freeWrites.pop(w, unused))
+                break;
+            if (len == 0) {
+                transform.finish(writes[w]);
+            } else {
+                transform.feed(reads[r].data(), len, writes[w]);
+                freeReads.push(r, 0);
+            }
+            if (writes[w].empty())
+                freeWrites.push(w, 0);
+            else
+                fullWrites.push(w, writes[w].size());
+            if (len == 0)
+                break;
+        }
+    } catch (...) {
+        freeReads.close();
+        fullWrites.close();
+        reader.join();
+        writer.join();
+        throw;
+    }
+    // Номер n - признак конца для потока записи
+    fullWrites.push(n, 0);
+    writer.join();
+    freeReads.close();
+    reader.join();
+    if (readError)
+        throw ioError(readError, "read");
+    if (writeError)
+        throw ioError(writeError, "write");
+}
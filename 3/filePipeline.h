@@ -0,0 +1,129 @@
+/**
+ * @file filePipeline.h
+ * @brief Конвейер чтение - шифрование - запись для одного файла
+ * @author Назарова Софья
+ * @date 2025
+ */
+
+#pragma once
+#include "cipherBackend.h"
+#include <filesystem>
+#include <string>
+
+/**
+ * @class streamTransform
+ * @brief Применение cipherBackend к тексту, поступающему частями
+ * @details Хранит незавершенную последовательность UTF-8 в конце
+ *          прочитанных данных и нормализованный остаток, не кратный
+ *          cipherBackend::unit(), до прихода следующей части
+ */
+class streamTransform {
+    public:
+        /**
+         * @brief Удаленный конструктор по умолчанию
+         */
+        streamTransform() = delete;
+
+        /**
+         * @brief Конструктор с шифром
+         * @param[in] backend Шифр
+         * @param[in] encrypting true - шифрование, false - дешифрование
+         */
+        streamTransform(const cipherBackend& backend, bool encrypting);
+
+        /**
+         * @brief Обработка очередной части исходных данных
+         * @param[in] data Данные
+         * @param[in] size Размер данных
+         * @param[out] out Результат для всех полных единиц (прежнее содержимое заменяется, память сохраняется)
+         * @throw std::invalid_argument при ошибках шифра
+         */
+        void feed(const char* data, size_t size, std::string& out);
+
+        /**
+         * @brief Обработка остатка после последней части
+         * @param[out] out Результат (прежнее содержимое заменяется, память сохраняется)
+         * @throw std::invalid_argument при ошибках шифра
+         */
+        void finish(std::string& out);
+
+    private:
+        const cipherBackend& backend; ///< Шифр
+        bool encrypting; ///< Направление преобразования
+        std::string raw; ///< Незавершенный символ UTF-8 и новые данные
+        std::string pending; ///< Нормализованный текст, еще не преобразованный
+        size_t offset = 0; ///< Смещение pending в нормализованном тексте
+};
+
+/**
+ * @struct pipelineOptions
+ * @brief Параметры конвейера
+ */
+struct pipelineOptions {
+    unsigned buffers = 4; ///< Количество буферов в пуле (одновременно в работе)
+    size_t bufferSize = 1 << 20; ///< Размер буфера чтения, байт
+    bool useUring = true; ///< Использовать io_uring, если ядро его поддерживает
+};
+
+/**
+ * @class filePipeline
+ * @brief Шифрование файла с перекрытием чтения, шифрования и записи
+ * @details Пока шифруется очередной буфер, следующие буферы уже читаются,
+ *          а результаты предыдущих записываются. Буферы чтения и записи
+ *          берутся из фиксированного пула: cipherBackend пишет результат
+ *          в буфер записи, сохраняя его память (временные строки внутри
+ *          самих шифров при этом возможны). Ввод-вывод выполняется через io_uring,
+ *          а если он недоступен - отдельными потоками чтения и записи
+ */
+class filePipeline {
+    public:
+        /**
+         * @brief Удаленный конструктор по умолчанию
+         */
+        filePipeline() = delete;
+
+        /**
+         * @brief Конструктор с шифром и параметрами
+         * @param[in] backend Шифр
+         * @param[in] encrypting true - шифрование, false - дешифрование
+         * @param[in] options Параметры конвейера
+         */
+        filePipeline(const cipherBackend& backend, bool encrypting,
+                     const pipelineOptions& options = pipelineOptions());
+
+        /**
+         * @brief Обработка файла
+         * @param[in] src Исходный файл
+         * @param[in] dst Файл результата (каталоги создаются; может совпадать с src)
+         * @throw std::system_error при ошибках ввода-вывода
+         * @throw std::invalid_argument при ошибках шифра
+         */
+        void process(const std::filesystem::path& src, const std::filesystem::path& dst);
+
+        /**
+         * @brief Использовался ли io_uring при последнем вызове process()
+         * @return true - io_uring, false - потоки
+         */
+        bool usedUring() const { return uringUsed; }
+
+    private:
+        /**
+         * @brief Обработка через io_uring
+         * @param[in] in Дескриптор исходного файла
+         * @param[in] out Дескриптор файла результата
+         * @return false, если io_uring недоступен и ничего не было сделано
+         */
+        bool processUring(int in, int out);
+
+        /**
+         * @brief Обработка потоками чтения и записи
+         * @param[in] in Дескриптор исходного файла
+         * @param[in] out Дескриптор файла результата
+         */
+        void processThreads(int in, int out);
+
+        const cipherBackend& backend; ///< Шифр
+        bool encrypting; ///< Направление преобразования
+        pipelineOptions options; ///< Параметры конвейера
+        bool uringUsed = false; ///< Способ ввода-вывода при последнем вызове
+};
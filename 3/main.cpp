@@ -0,0 +1,116 @@
+/**
+ * @file main.cpp
+ * @brief Консольная программа шифрования дерева каталогов
+ * @author Назарова Софья
+ * @date 2025
+ * @copyright WECT ПГУ
+ */
+
+#include "treeCrypt.h"
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+static const unsigned maxThreads = 4096; ///< Наибольшее значение -j
+
+/**
+ * @brief Вывод справки
+ * @param[in] name Имя программы
+ */
+static void usage(const char* name) {
+    fprintf(stderr,
+            "Использование: %s (-e|-d) (-a КЛЮЧ | -r СТОЛБЦЫ [-b БЛОК]) [-j ПОТОКИ] [-c БАЙТ] [-s] [-q] ИСТОЧНИК РЕЗУЛЬТАТ\n"
+            "  -e          шифрование\n"
+            "  -d          дешифрование\n"
+            "  -a КЛЮЧ     шифр modAlphaCipher с русским ключом\n"
+            "  -r СТОЛБЦЫ  шифр маршрутной перестановки\n"
+            "  -b БЛОК     размер блока перестановки в буквах (по умолчанию 4096)\n"
+            "  -j ПОТОКИ   количество потоков, 0 - по числу ядер (по умолчанию)\n"
+            "  -c БАЙТ     размер части файла и пакета мелких файлов (по умолчанию 1 МиБ)\n"
+            "  -s          потоковая обработка: чтение, шифрование и запись\n"
+            "              файлов больше части перекрываются (io_uring или потоки)\n"
+            "  -q          не выводить ход работы\n",
+            name);
+}
+
+/**
+ * @brief Разбор неотрицательного целого аргумента
+ * @param[in] s Строка аргумента
+ * @param[in] min Наименьшее допустимое значение
+ * @param[in] max Наибольшее допустимое значение
+ * @param[out] value Значение
+ * @return false, если строка не число или значение вне [min, max]
+ */
+static bool parseNumber(const char* s, unsigned long long min, unsigned long long max,
+                        unsigned long long& value) {
+    if (s[0] < '0' || s[0] > '9')
+        return false; // strtoull молча принимает "-1" и пробелы
+    char* end = nullptr;
+    errno = 0;
+    value = strtoull(s, &end, 10);
+    return errno == 0 && *end == '\0' && value >= min && value <= max;
+}
+
+/**
+ * @brief Точка входа
+ * @param[in] argc Количество аргументов командной строки
+ * @param[in] argv Аргументы командной строки
+ * @return 0 - все файлы обработаны, 1 - были ошибки, 2 - неверные аргументы
+ */
+int main(int argc, char** argv) {
+    treeOptions options;
+    int mode = 0;
+    const char* alphaKey = nullptr;
+    int routeKey = 0;
+    size_t block = 4096;
+    const char* paths[2] = {nullptr, nullptr};
+    int npaths = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        bool hasValue = i + 1 < argc;
+        unsigned long long value = 0;
+        if (!strcmp(a, "-e") || !strcmp(a, "-d")) {
+            mode = a[1];
+        } else if (!strcmp(a, "-a") && hasValue) {
+            alphaKey = argv[++i];
+        } else if (!strcmp(a, "-r") && hasValue && parseNumber(argv[++i], 2, INT_MAX, value)) {
+            routeKey = value;
+        } else if (!strcmp(a, "-b") && hasValue && parseNumber(argv[++i], 1, SIZE_MAX, value)) {
+            block = value;
+        } else if (!strcmp(a, "-j") && hasValue && parseNumber(argv[++i], 0, maxThreads, value)) {
+            options.threads = value;
+        } else if (!strcmp(a, "-c") && hasValue && parseNumber(argv[++i], 1, SIZE_MAX, value)) {
+            options.chunk = value;
+        } else if (!strcmp(a, "-s")) {
+            options.streaming = true;
+        } else if (!strcmp(a, "-q")) {
+            options.progress = false;
+        } else if (a[0] != '-' && npaths < 2) {
+            paths[npaths++] = a;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (mode == 0 || npaths != 2 || (alphaKey == nullptr) == (routeKey == 0)) {
+        usage(argv[0]);
+        return 2;
+    }
+    options.encrypting = mode == 'e';
+
+    try {
+        std::unique_ptr<cipherBackend> backend = alphaKey ? makeAlphaBackend(alphaKey)
+                                                          : makeRouteBackend(routeKey, block);
+        treeCrypt tree(*backend, options);
+        return tree.run(paths[0], paths[1]) == 0 ? 0 : 1;
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file routeBackend.cpp
+ * @brief Обработчик файлов для шифра маршрутной перестановки
+ * @author Назарова Софья
+ * @date 2025
+ * @copyright WECT ПГУ
+ */
+
+#include "cipherBackend.h"
+#include "../2/route.h"
+#include <algorithm>
+
+namespace {
+
+/**
+ * @class routeBackend
+ * @brief Обработчик для шифра маршрутной перестановки
+ * @details Нормализованный текст делится на блоки по block букв, каждый
+ *          блок переставляется отдельно. Последний блок может быть короче,
+ *          блок короче ключа остается без изменений
+ */
+class routeBackend: public cipherBackend {
+    public:
+        /**
+         * @brief Конструктор с ключом и размером блока
+         * @param[in] key Количество столбцов таблицы
+         * @param[in] block Размер блока в буквах
+         */
+        routeBackend(int key, size_t block): key(key), block(block) {}
+
+        void normalize(std::string_view raw, bool encrypting, std::string& out) const override;
+
+        size_t unit() const override { return block; }
+
+        void transform(std::string_view part, size_t offset, bool encrypting,
+                       std::string& out) const override;
+
+    private:
+        int key; ///< Количество столбцов таблицы
+        size_t block; ///< Размер блока в буквах
+};
+
+/**
+ * @brief Нормализация содержимого файла
+ * @param[in] raw Содержимое файла
+ * @param[in] encrypting Не используется: шифр сохраняет алфавит
+ * @param[in,out] out Буфер, в конец которого дописываются латинские буквы
+ */
+void routeBackend::normalize(std::string_view raw, bool, std::string& out) const {
+    out.reserve(out.size() + raw.size());
+    for (char c : raw)
+        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))
+            out.push_back(c);
+}
+
+/**
+ * @brief Преобразование части нормализованного текста
+ * @param[in] part Часть текста, начинающаяся на границе блока
+ * @param[in] offset Не используется: блоки независимы
+ * @param[in] encrypting true - шифрование, false - дешифрование
+ * @param[out] out Результат той же длины, что и part
+ * @details Один объект code обслуживает все полные блоки части,
+ *          поэтому маршрут компилируется один раз
+ */
+void routeBackend::transform(std::string_view part, size_t, bool encrypting,
+                             std::string& out) const {
+    out.clear();
+    if (part.size() < (size_t)key) {
+        out.append(part);
+        return;
+    }
+    code cipher(key, std::string(part.substr(0, std::min(block, part.size()))));
+    for (size_t pos = 0; pos < part.size(); pos += block) {
+        std::string_view b = part.substr(pos, block);
+        if (b.size() < (size_t)key) {
+            out.append(b);
+        } else {
+            std::string text(b);
+            out.append(encrypting ? cipher.encryption(text) : cipher.transcript(text, text));
+        }
+    }
+}
+
+}
+
+/**
+ * @brief Создание обработчика для шифра маршрутной перестановки
+ * @param[in] key Количество столбцов таблицы
+ * @param[in] block Размер блока в буквах
+ * @return Обработчик
+ * @throw std::invalid_argument при невалидном ключе или размере блока
+ */
+std::unique_ptr<cipherBackend> makeRouteBackend(int key, size_t block) {
+    if (key < 2)
+        throw std::invalid_argument("Ключ некорректного размера");
+    if (block < (size_t)key)
+        throw std::invalid_argument("Размер блока меньше ключа");
+    return std::unique_ptr<cipherBackend>(new routeBackend(key, block));
+}
@@ -0,0 +1,264 @@
+/**
+ * @file test.cpp
+ * @brief Тесты для пула потоков, обработчиков файлов и обработки дерева каталогов
+ * @author Назарова Софья
+ * @date 2025
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include "cipherBackend.h"
+#include "filePipeline.h"
+#include "treeCrypt.h"
+#include "workStealingPool.h"
+#include "../common/cipher_error.h"
+#include <atomic>
+#include <map>
+
+/**
+ * @test Suite PoolTest
+ * @brief Тесты для пула потоков
+ */
+SUITE(PoolTest)
+{
+    /**
+     * @test AllTasksRun
+     * @brief Выполняются все задачи, включая поставленные из рабочих потоков
+     */
+    TEST(AllTasksRun) {
+        std::atomic<int> done{0};
+        workStealingPool pool(4);
+        for (int i = 0; i < 100; i++)
+            pool.submit([&] {
+                for (int j = 0; j < 10; j++)
+                    pool.submit([&] { done++; });
+                done++;
+            });
+        pool.wait();
+        CHECK_EQUAL(1100, done.load());
+    }
+}
+
+/**
+ * @test Suite BackendTest
+ * @brief Тесты для обработчиков файлов
+ */
+SUITE(BackendTest)
+{
+    /**
+     * @test AlphaParts
+     * @brief Шифрование по частям совпадает с шифрованием целиком
+     */
+    TEST(AlphaParts) {
+        std::unique_ptr<cipherBackend> b = makeAlphaBackend("БОРЩ");
+        std::string text = b->normalize("Суп с фрикадельками,\nкаша.", true);
+        CHECK_EQUAL("СУПСФРИКАДЕЛЬКАМИКАША", text);
+        std::string whole = b->transform(text, 0, true);
+        std::string parts = b->transform(text.substr(0, 6), 0, true) +
+                            b->transform(text.substr(6), 6, true);
+        CHECK_EQUAL(whole, parts);
+        CHECK_EQUAL(text, b->transform(b->normalize(whole + "\n", false), 0, false));
+    }
+
+    /**
+     * @test BufferReuse
+     * @brief Результат пишется в буфер вызывающей стороны без выделения новой памяти
+     */
+    TEST(BufferReuse) {
+        std::unique_ptr<cipherBackend> alpha = makeAlphaBackend("БОРЩ");
+        std::unique_ptr<cipherBackend> route = makeRouteBackend(3, 6);
+        for (const cipherBackend* b : {alpha.get(), route.get()}) {
+            std::string text = b->normalize("Суп с фрикадельками PRIVET privet", true);
+            std::string out;
+            out.reserve(1024);
+            const char* memory = out.data();
+            for (int i = 0; i < 2; i++) {
+                b->transform(text, 0, true, out);
+                CHECK_EQUAL(b->transform(text, 0, true), out);
+                CHECK(memory == out.data());
+            }
+        }
+    }
+
+    /**
+     * @test AlphaMalformed
+     * @brief Некорректная UTF-8 при шифровании и дешифровании (ожидается исключение)
+     */
+    TEST(AlphaMalformed) {
+        std::unique_ptr<cipherBackend> b = makeAlphaBackend("БОРЩ");
+        CHECK_THROW(b->normalize("Суп\xD1\x41", true), cipher_error);
+        CHECK_THROW(b->normalize("\xC0\x80", true), cipher_error);
+        CHECK_THROW(b->normalize("СУП\x81", false), cipher_error);
+    }
+
+    /**
+     * @test RouteBlocks
+     * @brief Блочная перестановка обратима, короткий последний блок не меняется
+     */
+    TEST(RouteBlocks) {
+        std::unique_ptr<cipherBackend> b = makeRouteBackend(3, 6);
+        std::string text = b->normalize("PRIVET privet\nPR", true);
+        CHECK_EQUAL("PRIVETprivetPR", text);
+        std::string enc = b->transform(text, 0, true);
+        CHECK_EQUAL("ITREPVitrepvPR", enc);
+        CHECK_EQUAL(text, b->transform(enc, 0, false));
+    }
+
+    /**
+     * @test RouteBadBlock
+     * @brief Блок меньше ключа (ожидается исключение)
+     */
+    TEST(RouteBadBlock) {
+        CHECK_THROW(makeRouteBackend(5, 4), std::invalid_argument);
+    }
+}
+
+/**
+ * @test Suite PipelineTest
+ * @brief Тесты для конвейера обработки файлов
+ */
+SUITE(PipelineTest)
+{
+    /**
+     * @brief Обработка файла конвейером с маленькими буферами
+     * @param[in] useUring Использовать io_uring
+     * @return Пара: результат конвейера и результат шифрования целиком
+     */
+    std::pair<std::string, std::string> run(bool useUring) {
+        std::unique_ptr<cipherBackend> b = makeAlphaBackend("БОРЩ");
+        std::string text;
+        for (int i = 0; i < 500; i++)
+            text += "Суп с фрикадельками, каша.\n";
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / "lb3_pipeline_test";
+        writeFile(dir / "in.txt", text);
+
+        pipelineOptions options;
+        options.buffers = 3;
+        options.bufferSize = 7; // нечетный размер режет символы UTF-8 пополам
+        options.useUring = useUring;
+        filePipeline(*b, true, options).process(dir / "in.txt", dir / "out.txt");
+        std::string result = readFile(dir / "out.txt");
+        std::filesystem::remove_all(dir);
+        return {result, b->transform(b->normalize(text, true), 0, true)};
+    }
+
+    /**
+     * @test Uring
+     * @brief Результат через io_uring (или запасной путь) совпадает с шифрованием целиком
+     */
+    TEST(Uring) {
+        auto r = run(true);
+        CHECK_EQUAL(r.second, r.first);
+    }
+
+    /**
+     * @test Threads
+     * @brief Результат через потоки совпадает с шифрованием целиком
+     */
+    TEST(Threads) {
+        auto r = run(false);
+        CHECK_EQUAL(r.second, r.first);
+    }
+
+    /**
+     * @test InPlace
+     * @brief Файл результата совпадает с исходным
+     */
+    TEST(InPlace) {
+        std::unique_ptr<cipherBackend> b = makeAlphaBackend("БОРЩ");
+        std::string text;
+        for (int i = 0; i < 500; i++)
+            text += "Суп с фрикадельками, каша.\n";
+        std::string expected = b->transform(b->normalize(text, true), 0, true);
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / "lb3_pipeline_inplace";
+        std::filesystem::remove_all(dir);
+
+        for (bool useUring : {true, false}) {
+            writeFile(dir / "in.txt", text);
+            pipelineOptions options;
+            options.buffers = 3;
+            options.bufferSize = 7;
+            options.useUring = useUring;
+            filePipeline(*b, true, options).process(dir / "in.txt", dir / "in.txt");
+            CHECK_EQUAL(expected, readFile(dir / "in.txt"));
+            CHECK_EQUAL(1, std::distance(std::filesystem::directory_iterator(dir),
+                                         std::filesystem::directory_iterator()));
+        }
+        std::filesystem::remove_all(dir);
+    }
+
+    /**
+     * @test ErrorInFlight
+     * @brief Ошибка шифра при незавершенных чтениях (ожидается исключение)
+     */
+    TEST(ErrorInFlight) {
+        std::unique_ptr<cipherBackend> b = makeAlphaBackend("БОРЩ");
+        std::string text = "СУПКАША LATIN";
+        for (int i = 0; i < 500; i++)
+            text += "СУПКАША";
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / "lb3_pipeline_error";
+        writeFile(dir / "in.txt", text);
+
+        for (bool useUring : {true, false}) {
+            pipelineOptions options;
+            options.buffers = 4;
+            options.bufferSize = 8;
+            options.useUring = useUring;
+            filePipeline pipeline(*b, false, options);
+            CHECK_THROW(pipeline.process(dir / "in.txt", dir / "out.txt"), cipher_error);
+        }
+        // Временный файл удален, результата нет
+        CHECK_EQUAL(1, std::distance(std::filesystem::directory_iterator(dir),
+                                     std::filesystem::directory_iterator()));
+        std::filesystem::remove_all(dir);
+    }
+}
+
+/**
+ * @test Suite TreeTest
+ * @brief Тесты для шифрования дерева каталогов
+ */
+SUITE(TreeTest)
+{
+    /**
+     * @test LargeAndSmallFiles
+     * @brief Большой файл делится на части, мелкие собираются в пакеты;
+     *        результат каждого файла совпадает с шифрованием целиком
+     */
+    TEST(LargeAndSmallFiles) {
+        std::unique_ptr<cipherBackend> b = makeAlphaBackend("БОРЩ");
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / "lb3_tree_test";
+        std::filesystem::remove_all(dir);
+        std::map<std::string, std::string> files;
+        for (int i = 0; i < 300; i++)
+            files["big.txt"] += "Суп с фрикадельками, каша.\n";
+        for (int i = 0; i < 6; i++)
+            files["sub/small" + std::to_string(i) + ".txt"] = "Щи да каша - пища наша" + std::string(i, '!');
+        for (const auto& f : files)
+            writeFile(dir / "src" / f.first, f.second);
+
+        treeOptions options;
+        options.threads = 4;
+        options.chunk = 64;
+        options.progress = false;
+        treeCrypt tree(*b, options);
+        for (int pass = 0; pass < 2; pass++) {
+            CHECK_EQUAL(0u, tree.run(dir / "src", dir / "dst"));
+            for (const auto& f : files)
+                CHECK_EQUAL(b->transform(b->normalize(f.second, true), 0, true),
+                            readFile(dir / "dst" / f.first));
+        }
+
+        writeFile(dir / "src" / "bad.txt", "Суп\xD1\x41");
+        CHECK_EQUAL(1u, tree.run(dir / "src", dir / "dst"));
+        std::filesystem::remove_all(dir);
+    }
+}
+
+/**
+ * @brief Главная функция для запуска тестов
+ * @return Код завершения (0 - все тесты прошли успешно)
+ */
+int main()
+{
+    return UnitTest::RunAllTests();
+}
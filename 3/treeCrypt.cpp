@@ -0,0 +1,245 @@
+/**
+ * @file treeCrypt.cpp
+ * @brief Реализация параллельного шифрования дерева каталогов
+ * @author Назарова Софья
+ * @date 2025
+ * @copyright WECT ПГУ
+ */
+
+#include "treeCrypt.h"
+#include "filePipeline.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Чтение файла целиком
+ * @param[in] path Путь к файлу
+ * @return Содержимое файла
+ * @throw std::runtime_error если файл нельзя прочитать
+ */
+std::string readFile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("Не удалось открыть файл");
+    std::string data(fs::file_size(path), '\0');
+    in.read(&data[0], data.size());
+    data.resize(in.gcount());
+    return data;
+}
+
+/**
+ * @brief Запись файла с созданием недостающих каталогов
+ * @param[in] path Путь к файлу
+ * @param[in] data Содержимое
+ * @throw std::runtime_error если файл нельзя записать
+ */
+void writeFile(const fs::path& path, const std::string& data) {
+    fs::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.write(data.data(), data.size()))
+        throw std::runtime_error("Не удалось записать файл");
+}
+
+/**
+ * @brief Конструктор с шифром и параметрами
+ * @param[in] backend Шифр
+ * @param[in] options Параметры обработки
+ */
+treeCrypt::treeCrypt(const cipherBackend& backend, const treeOptions& options):
+    backend(backend), options(options) {
+    size_t unit = backend.unit();
+    this->options.chunk = std::max(unit, this->options.chunk / unit * unit);
+}
+
+/**
+ * @brief Обработка дерева каталогов
+ * @param[in] src Исходный каталог
+ * @param[in] dst Каталог для результатов
+ * @return Количество файлов, которые не удалось обработать
+ * @details Большие файлы ставятся в пул первыми, чтобы их части начали
+ *          выполняться раньше и не задерживали окончание работы
+ */
+size_t treeCrypt::run(const fs::path& src, const fs::path& dst) {
+    std::vector<fileEntry> large, small;
+    bytesTotal = 0;
+    for (const auto& e : fs::recursive_directory_iterator(src)) {
+        if (!e.is_regular_file())
+            continue;
+        fileEntry f = {e.path(), dst / fs::relative(e.path(), src), e.file_size()};
+        bool split = f.size >= options.chunk && !options.streaming;
+        (split ? large : small).push_back(f);
+        bytesTotal += f.size;
+    }
+    filesTotal = large.size() + small.size();
+    filesDone = 0;
+    failures = 0;
+    bytesDone = 0;
+
+    std::sort(large.begin(), large.end(), [](const fileEntry& a, const fileEntry& b) {
+        return a.size > b.size;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<bool> finished{false};
+    std::thread reporter;
+    if (options.progress)
+        reporter = std::thread([&] {
+            while (!finished) {
+                report(start);
+                std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            }
+        });
+
+    {
+        workStealingPool workers(options.threads);
+        pool = &workers;
+        for (const fileEntry& f : large)
+            workers.submit([this, f] { processLarge(f); });
+
+        std::vector<fileEntry> batch;
+        uintmax_t batchBytes = 0;
+        for (const fileEntry& f : small) {
+            batch.push_back(f);
+            batchBytes += f.size;
+            if (batchBytes >= options.chunk) {
+                workers.submit([this, batch] { processBatch(batch); });
+                batch.clear();
+                batchBytes = 0;
+            }
+        }
+        if (!batch.empty())
+            workers.submit([this, batch] { processBatch(batch); });
+        workers.wait();
+        pool = nullptr;
+    }
+
+    if (options.progress) {
+        finished = true;
+        reporter.join();
+        report(start);
+        fputc('\n', stderr);
+    }
+    return failures;
+}
+
+/**
+ * @brief Обработка пакета мелких файлов
+ * @param[in] batch Файлы пакета
+ */
+void treeCrypt::processBatch(const std::vector<fileEntry>& batch) {
+    pipelineOptions streamOptions;
+    streamOptions.bufferSize = options.chunk;
+    for (const fileEntry& f : batch) {
+        try {
+            if (options.streaming && f.size > options.chunk) {
+                filePipeline(backend, options.encrypting, streamOptions).process(f.src, f.dst);
+            } else {
+                std::string text = backend.normalize(readFile(f.src), options.encrypting);
+                std::string out;
+                out.reserve(text.size());
+                for (size_t pos = 0; pos < text.size(); pos += options.chunk)
+                    out += backend.transform(std::string_view(text).substr(pos, options.chunk), pos, options.encrypting);
+                writeFile(f.dst, out);
+            }
+        } catch (const std::exception& e) {
+            fail(f, e.what());
+        }
+        bytesDone += f.size;
+        filesDone++;
+    }
+}
+
+/**
+ * @brief Разбиение большого файла на части и постановка их в пул
+ * @param[in] file Файл
+ * @details Части пишут результат в общий буфер, последняя завершившаяся
+ *          часть записывает файл
+ */
+void treeCrypt::processLarge(const fileEntry& file) {
+    /**
+     * @struct largeFile
+     * @brief Общее состояние частей одного файла
+     */
+    struct largeFile {
+        fileEntry file; ///< Файл
+        std::string text; ///< Нормализованный текст
+        std::string out; ///< Результат
+        std::atomic<size_t> remaining{0}; ///< Необработанные части
+        std::atomic<bool> failed{false}; ///< Признак ошибки
+    };
+
+    auto state = std::make_shared<largeFile>();
+    state->file = file;
+    try {
+        state->text = backend.normalize(readFile(file.src), options.encrypting);
+    } catch (const std::exception& e) {
+        fail(file, e.what());
+        bytesDone += file.size;
+        filesDone++;
+        return;
+    }
+    state->out.resize(state->text.size());
+
+    size_t step = options.chunk;
+    size_t parts = std::max<size_t>(1, (state->text.size() + step - 1) / step);
+    state->remaining = parts;
+    for (size_t i = 0; i < parts; i++) {
+        pool->submit([this, state, step, i] {
+            size_t pos = i * step;
+            size_t len = std::min(step, state->text.size() - pos);
+            if (!state->failed) {
+                try {
+                    std::string r = backend.transform(std::string_view(state->text).substr(pos, len), pos, options.encrypting);
+                    if (r.size() != len)
+                        throw std::runtime_error("Длина результата не совпадает с исходной");
+                    memcpy(&state->out[pos], r.data(), len);
+                } catch (const std::exception& e) {
+                    if (!state->failed.exchange(true))
+                        fail(state->file, e.what());
+                }
+            }
+            bytesDone += state->text.empty() ? state->file.size : state->file.size * len / state->text.size();
+            if (--state->remaining == 0) {
+                if (!state->failed) {
+                    try {
+                        writeFile(state->file.dst, state->out);
+                    } catch (const std::exception& e) {
+                        fail(state->file, e.what());
+                    }
+                }
+                filesDone++;
+            }
+        });
+    }
+}
+
+/**
+ * @brief Учет ошибки обработки файла
+ * @param[in] file Файл
+ * @param[in] what Сообщение об ошибке
+ */
+void treeCrypt::fail(const fileEntry& file, const char* what) {
+    failures++;
+    std::lock_guard<std::mutex> g(outputLock);
+    fprintf(stderr, "\n%s: %s\n", file.src.string().c_str(), what);
+}
+
+/**
+ * @brief Вывод хода работы
+ * @param[in] start Момент начала работы
+ */
+void treeCrypt::report(std::chrono::steady_clock::time_point start) {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double mib = bytesDone / 1048576.0;
+    std::lock_guard<std::mutex> g(outputLock);
+    fprintf(stderr, "\rфайлы %zu/%zu, %.1f/%.1f МиБ, %.1f МиБ/с",
+            filesDone.load(), filesTotal, mib, bytesTotal / 1048576.0,
+            seconds > 0 ? mib / seconds : 0.0);
+}
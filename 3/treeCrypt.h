@@ -0,0 +1,127 @@
+/**
+ * @file treeCrypt.h
+ * @brief Параллельное шифрование дерева каталогов
+ * @author Назарова Софья
+ * @date 2025
+ */
+
+#pragma once
+#include "cipherBackend.h"
+#include "workStealingPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @struct treeOptions
+ * @brief Параметры обработки дерева каталогов
+ */
+struct treeOptions {
+    bool encrypting = true; ///< true - шифрование, false - дешифрование
+    unsigned threads = 0; ///< Количество потоков (0 - по числу ядер)
+    size_t chunk = 1 << 20; ///< Размер части большого файла и пакета мелких файлов, байт (округляется до cipherBackend::unit())
+    bool progress = true; ///< Выводить ход работы в stderr
+    bool streaming = false; ///< Обрабатывать файлы больше chunk конвейером filePipeline, не загружая целиком
+};
+
+/**
+ * @class treeCrypt
+ * @brief Шифрование всех файлов каталога с сохранением структуры
+ * @details Файлы не меньше chunk байт делятся на части, которые
+ *          обрабатываются параллельно; мелкие файлы собираются в пакеты
+ *          примерно по chunk байт, и каждый пакет - одна задача.
+ *          В режиме streaming файлы больше chunk байт обрабатываются
+ *          одной задачей через filePipeline с буферами по chunk байт;
+ *          меньшие файлы читаются целиком, так как помещаются в один
+ *          буфер и не окупают создание кольца io_uring или потоков.
+ *          Задачи выполняет workStealingPool
+ */
+class treeCrypt {
+    public:
+        /**
+         * @brief Удаленный конструктор по умолчанию
+         */
+        treeCrypt() = delete;
+
+        /**
+         * @brief Конструктор с шифром и параметрами
+         * @param[in] backend Шифр
+         * @param[in] options Параметры обработки
+         */
+        treeCrypt(const cipherBackend& backend, const treeOptions& options);
+
+        /**
+         * @brief Обработка дерева каталогов
+         * @param[in] src Исходный каталог
+         * @param[in] dst Каталог для результатов
+         * @return Количество файлов, которые не удалось обработать
+         * @throw std::filesystem::filesystem_error если src нельзя прочитать
+         */
+        size_t run(const std::filesystem::path& src, const std::filesystem::path& dst);
+
+    private:
+        /**
+         * @struct fileEntry
+         * @brief Файл для обработки
+         */
+        struct fileEntry {
+            std::filesystem::path src; ///< Исходный файл
+            std::filesystem::path dst; ///< Файл результата
+            uintmax_t size; ///< Размер исходного файла
+        };
+
+        /**
+         * @brief Обработка пакета мелких файлов
+         * @param[in] batch Файлы пакета
+         */
+        void processBatch(const std::vector<fileEntry>& batch);
+
+        /**
+         * @brief Разбиение большого файла на части и постановка их в пул
+         * @param[in] file Файл
+         */
+        void processLarge(const fileEntry& file);
+
+        /**
+         * @brief Учет ошибки обработки файла
+         * @param[in] file Файл
+         * @param[in] what Сообщение об ошибке
+         */
+        void fail(const fileEntry& file, const char* what);
+
+        /**
+         * @brief Вывод хода работы до завершения всех задач
+         * @param[in] start Момент начала работы
+         */
+        void report(std::chrono::steady_clock::time_point start);
+
+        const cipherBackend& backend; ///< Шифр
+        treeOptions options; ///< Параметры обработки
+        workStealingPool* pool = nullptr; ///< Пул текущего запуска run()
+        std::atomic<size_t> filesDone{0}; ///< Обработанные файлы
+        std::atomic<size_t> failures{0}; ///< Файлы с ошибками
+        std::atomic<uintmax_t> bytesDone{0}; ///< Обработанные байты исходных файлов
+        size_t filesTotal = 0; ///< Всего файлов
+        uintmax_t bytesTotal = 0; ///< Всего байт
+        std::mutex outputLock; ///< Защита вывода в stderr
+};
+
+/**
+ * @brief Чтение файла целиком
+ * @param[in] path Путь к файлу
+ * @return Содержимое файла
+ * @throw std::runtime_error если файл нельзя прочитать
+ */
+std::string readFile(const std::filesystem::path& path);
+
+/**
+ * @brief Запись файла с созданием недостающих каталогов
+ * @param[in] path Путь к файлу
+ * @param[in] data Содержимое
+ * @throw std::runtime_error если файл нельзя записать
+ */
+void writeFile(const std::filesystem::path& path, const std::string& data);
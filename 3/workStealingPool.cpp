@@ -0,0 +1,127 @@
+/**
+ * @file workStealingPool.cpp
+ * @brief Реализация пула потоков с перехватом задач
+ * @author Назарова Софья
+ * @date 2025
+ * @copyright WECT ПГУ
+ */
+
+#include "workStealingPool.h"
+#include <algorithm>
+
+namespace {
+    thread_local workStealingPool* currentPool = nullptr; ///< Пул текущего рабочего потока
+    thread_local unsigned currentIndex = 0; ///< Номер текущего рабочего потока
+}
+
+/**
+ * @brief Конструктор с количеством потоков
+ * @param[in] threads Количество рабочих потоков (0 - по числу ядер)
+ */
+workStealingPool::workStealingPool(unsigned threads) {
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; i++)
+        queues.emplace_back(new queue);
+    for (unsigned i = 0; i < threads; i++)
+        workers.emplace_back(&workStealingPool::run, this, i);
+}
+
+/**
+ * @brief Деструктор: дожидается задач и останавливает потоки
+ */
+workStealingPool::~workStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> g(idleLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& w : workers)
+        w.join();
+}
+
+/**
+ * @brief Постановка задачи
+ * @param[in] task Задача, не выбрасывающая исключений
+ */
+void workStealingPool::submit(std::function<void()> task) {
+    unsigned index = currentPool == this ? currentIndex
+                                         : nextQueue++ % queues.size();
+    pending++;
+    {
+        std::lock_guard<std::mutex> g(queues[index]->lock);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Под idleLock, чтобы сигнал не потерялся между проверкой и засыпанием
+        std::lock_guard<std::mutex> g(idleLock);
+        queued++;
+    }
+    wakeUp.notify_one();
+}
+
+/**
+ * @brief Ожидание выполнения всех поставленных задач
+ */
+void workStealingPool::wait() {
+    std::unique_lock<std::mutex> g(idleLock);
+    allDone.wait(g, [this] { return pending == 0; });
+}
+
+/**
+ * @brief Извлечение задачи: своя очередь, затем чужие
+ * @param[in] index Номер потока
+ * @param[out] task Извлеченная задача
+ * @return true, если задача найдена
+ * @details Из своей очереди берется последняя задача (она еще в кэше),
+ *          из чужой - первая (обычно самая крупная)
+ */
+bool workStealingPool::take(unsigned index, std::function<void()>& task) {
+    {
+        queue& own = *queues[index];
+        std::lock_guard<std::mutex> g(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+    for (unsigned i = 1; i < queues.size(); i++) {
+        queue& victim = *queues[(index + i) % queues.size()];
+        std::lock_guard<std::mutex> g(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Цикл рабочего потока
+ * @param[in] index Номер потока
+ */
+void workStealingPool::run(unsigned index) {
+    currentPool = this;
+    currentIndex = index;
+    std::function<void()> task;
+    for (;;) {
+        if (take(index, task)) {
+            task();
+            task = nullptr;
+            if (--pending == 0) {
+                { std::lock_guard<std::mutex> g(idleLock); }
+                allDone.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> g(idleLock);
+        if (stopping)
+            return;
+        wakeUp.wait(g, [this] { return stopping || queued > 0; });
+    }
+}
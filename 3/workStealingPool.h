@@ -0,0 +1,99 @@
+/**
+ * @file workStealingPool.h
+ * @brief Пул потоков с перехватом задач (work stealing)
+ * @author Назарова Софья
+ * @date 2025
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class workStealingPool
+ * @brief Пул потоков, в котором у каждого потока своя очередь задач
+ * @details Задача, поставленная из рабочего потока, попадает в его собственную
+ *          очередь и выполняется им же в порядке LIFO. Освободившийся поток
+ *          забирает самые старые задачи из чужих очередей, поэтому куски
+ *          большого файла расходятся по всем ядрам, а не ждут одного потока
+ */
+class workStealingPool {
+    public:
+        /**
+         * @brief Удаленный конструктор по умолчанию
+         */
+        workStealingPool() = delete;
+
+        /**
+         * @brief Конструктор с количеством потоков
+         * @param[in] threads Количество рабочих потоков (0 - по числу ядер)
+         */
+        explicit workStealingPool(unsigned threads);
+
+        /**
+         * @brief Деструктор: дожидается задач и останавливает потоки
+         */
+        ~workStealingPool();
+
+        workStealingPool(const workStealingPool&) = delete;
+        workStealingPool& operator=(const workStealingPool&) = delete;
+
+        /**
+         * @brief Постановка задачи
+         * @param[in] task Задача, не выбрасывающая исключений
+         * @details Из рабочего потока задача ставится в его очередь,
+         *          из внешнего - в очереди по кругу
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Ожидание выполнения всех поставленных задач
+         */
+        void wait();
+
+        /**
+         * @brief Количество рабочих потоков
+         * @return Количество потоков
+         */
+        unsigned size() const { return workers.size(); }
+
+    private:
+        /**
+         * @struct queue
+         * @brief Очередь задач одного потока
+         */
+        struct queue {
+            std::mutex lock; ///< Защита очереди
+            std::deque<std::function<void()>> tasks; ///< Задачи
+        };
+
+        /**
+         * @brief Цикл рабочего потока
+         * @param[in] index Номер потока
+         */
+        void run(unsigned index);
+
+        /**
+         * @brief Извлечение задачи: своя очередь, затем чужие
+         * @param[in] index Номер потока
+         * @param[out] task Извлеченная задача
+         * @return true, если задача найдена
+         */
+        bool take(unsigned index, std::function<void()>& task);
+
+        std::vector<std::unique_ptr<queue>> queues; ///< Очереди потоков
+        std::vector<std::thread> workers; ///< Рабочие потоки
+        std::mutex idleLock; ///< Защита ожидания
+        std::condition_variable wakeUp; ///< Сигнал о новой задаче
+        std::condition_variable allDone; ///< Сигнал о выполнении всех задач
+        std::atomic<size_t> pending{0}; ///< Поставленные, но не выполненные задачи
+        std::atomic<size_t> queued{0}; ///< Задачи, ожидающие в очередях
+        std::atomic<unsigned> nextQueue{0}; ///< Очередь для задач из внешних потоков
+        bool stopping = false; ///< Признак остановки
+};
@@ -0,0 +1,33 @@
+/**
+ * @file cipher_error.h
+ * @brief Исключение, общее для шифров modAlphaCipher и code
+ * @author Назарова Софья
+ * @date 2025
+ */
+
+#pragma once
+#include <stdexcept>
+#include <string>
+
+/**
+ * @class cipher_error
+ * @brief Исключение для ошибок шифрования
+ * @details Наследуется от std::invalid_argument, используется для обработки ошибок
+ *          при работе с шифром
+ */
+class cipher_error: public std::invalid_argument {
+    public:
+        /**
+         * @brief Конструктор с строкой
+         * @param[in] what_arg Сообщение об ошибке
+         */
+        explicit cipher_error (const std::string& what_arg):
+        std::invalid_argument(what_arg) {}
+        
+        /**
+         * @brief Конструктор с си-строкой
+         * @param[in] what_arg Сообщение об ошибке
+         */
+        explicit cipher_error (const char* what_arg):
+        std::invalid_argument(what_arg) {}
+};
@@ -0,0 +1,167 @@
+/**
+ * @file bench.cpp
+ * @brief Нагрузочный тест библиотеки; служит обучающей нагрузкой для PGO
+ * @author Назарова Софья
+ * @date 2025
+ * @copyright WECT ПГУ
+ */
+
+#include "lb3cipher.h"
+#include "../1/alphaBroadcast.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Случайные тексты из заданных букв с пробелами и знаками препинания
+ * @param[in] letters Буквы в UTF-8
+ * @param[in] count Количество текстов
+ * @param[in] size Средняя длина текста в буквах
+ * @param[in] gen Генератор случайных чисел
+ * @return Тексты
+ */
+std::vector<std::string> makeTexts(const std::vector<std::string>& letters, size_t count,
+                                   size_t size, std::mt19937& gen) {
+    std::vector<std::string> texts(count);
+    for (std::string& t : texts) {
+        size_t n = size / 2 + gen() % size;
+        for (size_t i = 0; i < n; i++) {
+            t += letters[gen() % letters.size()];
+            if (gen() % 8 == 0)
+                t += ' ';
+        }
+    }
+    return texts;
+}
+
+/**
+ * @brief Вывод пропускной способности
+ * @param[in] name Название замера
+ * @param[in] bytes Обработано байт
+ * @param[in] start Момент начала замера
+ */
+void report(const char* name, size_t bytes, std::chrono::steady_clock::time_point start) {
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%-24s %8.1f МиБ/с\n", name, bytes / 1048576.0 / s);
+}
+
+/**
+ * @brief Пакетная обработка текстов через C-интерфейс
+ * @param[in] texts Тексты
+ * @param[in] call Пакетная функция библиотеки
+ * @return Результаты
+ */
+template <typename F>
+std::vector<std::string> runBatch(const std::vector<std::string>& texts, F call) {
+    std::vector<lb3_slice> in;
+    size_t capacity = 0;
+    for (const std::string& t : texts) {
+        in.push_back({t.data(), t.size()});
+        capacity += t.size();
+    }
+    std::string out(capacity, '\0');
+    std::vector<size_t> offsets(texts.size() + 1);
+    if (call(in.data(), in.size(), &out[0], capacity, offsets.data()) != LB3_OK) {
+        fprintf(stderr, "%s\n", lb3_last_error());
+        exit(1);
+    }
+    std::vector<std::string> result;
+    for (size_t i = 0; i < texts.size(); i++)
+        result.push_back(out.substr(offsets[i], offsets[i + 1] - offsets[i]));
+    return result;
+}
+
+}
+
+/**
+ * @brief Точка входа
+ * @param[in] argc Количество аргументов командной строки
+ * @param[in] argv Необязательный множитель объема нагрузки
+ * @return 0 - успешно
+ */
+int main(int argc, char** argv) {
+    size_t scale = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1;
+    std::mt19937 gen(2025);
+    std::vector<std::string> russian, latin;
+    for (const char* c : {"А", "Б", "В", "Г", "Д", "Е", "Ж", "З", "И", "Й", "К", "Л", "М", "Н", "О", "П",
+                          "Р", "С", "Т", "У", "Ф", "Х", "Ц", "Ч", "Ш", "Щ", "Ъ", "Ы", "Ь", "Э", "Ю", "Я",
+                          "а", "о", "е", "и", "н", "т"})
+        russian.push_back(c);
+    for (char c = 'a'; c <= 'z'; c++)
+        latin.push_back(std::string(1, c));
+
+    std::vector<std::string> ru = makeTexts(russian, 2000 * scale, 400, gen);
+    std::vector<std::string> en = makeTexts(latin, 2000 * scale, 400, gen);
+    size_t ruBytes = 0, enBytes = 0;
+    for (const std::string& t : ru)
+        ruBytes += t.size();
+    for (const std::string& t : en)
+        enBytes += t.size();
+
+    lb3_alpha* alpha;
+    lb3_route* columns;
+    lb3_route* spiral;
+    if (lb3_alpha_new("ПОМИДОРЫ", &alpha) != LB3_OK ||
+        lb3_route_new(7, LB3_ROUTE_COLUMNS, nullptr, &columns) != LB3_OK ||
+        lb3_route_new(7, LB3_ROUTE_SPIRAL, nullptr, &spiral) != LB3_OK) {
+        fprintf(stderr, "%s\n", lb3_last_error());
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> enc = runBatch(ru, [&](const lb3_slice* in, size_t n, char* out, size_t cap, size_t* off) {
+        return lb3_alpha_encrypt_batch(alpha, in, n, out, cap, off, nullptr);
+    });
+    report("alpha encrypt", ruBytes, start);
+    start = std::chrono::steady_clock::now();
+    runBatch(enc, [&](const lb3_slice* in, size_t n, char* out, size_t cap, size_t* off) {
+        return lb3_alpha_decrypt_batch(alpha, in, n, out, cap, off, nullptr);
+    });
+    report("alpha decrypt", ruBytes, start);
+
+    for (lb3_route* r : {columns, spiral}) {
+        for (const std::vector<std::string>* texts : {&en, &ru}) {
+            size_t bytes = texts == &en ? enBytes : ruBytes;
+            start = std::chrono::steady_clock::now();
+            std::vector<std::string> e = runBatch(*texts, [&](const lb3_slice* in, size_t n, char* out, size_t cap, size_t* off) {
+                return lb3_route_encrypt_batch(r, in, n, out, cap, off, nullptr);
+            });
+            runBatch(e, [&](const lb3_slice* in, size_t n, char* out, size_t cap, size_t* off) {
+                return lb3_route_decrypt_batch(r, in, n, out, cap, off, nullptr);
+            });
+            report(r == columns ? (texts == &en ? "route columns latin" : "route columns cyrillic")
+                                : (texts == &en ? "route spiral latin" : "route spiral cyrillic"),
+                   2 * bytes, start);
+        }
+    }
+
+    std::vector<std::string> keys;
+    for (size_t k = 0; keys.size() < 200; k++) {
+        std::string key;
+        for (size_t i = 0; i < 3 + k % 7; i++)
+            key += russian[gen() % 32];
+        try {
+            modAlphaCipher check(key);
+            keys.push_back(key);
+        } catch (const cipher_error&) {
+        }
+    }
+    alphaBroadcast broadcast(keys);
+    start = std::chrono::steady_clock::now();
+    size_t bytes = 0;
+    for (size_t i = 0; i < ru.size() / 10; i++) {
+        broadcastText r = broadcast.encrypt(ru[i]);
+        bytes += r[0].size() * r.size();
+    }
+    report("alpha broadcast", bytes, start);
+
+    lb3_alpha_free(alpha);
+    lb3_route_free(columns);
+    lb3_route_free(spiral);
+    return 0;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file lb3cipher.cpp
+ * @brief Реализация C-интерфейса библиотеки шифров
+ * @author Назарова Софья
+ * @date 2025
+ * @copyright WECT ПГУ
+ */
+
+#include "lb3cipher.h"
+#include "../1/modAlphaCipher.h"
+#include "../2/route.h"
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+/**
+ * @struct lb3_alpha
+ * @brief Шифр modAlphaCipher за C-интерфейсом
+ */
+struct lb3_alpha {
+    const modAlphaCipher cipher; ///< Шифр (только константные методы, общий для потоков)
+};
+
+/**
+ * @struct lb3_route
+ * @brief Параметры шифра маршрутной перестановки за C-интерфейсом
+ * @details Объект code хранит скомпилированные планы и меняется при
+ *          шифровании, поэтому у каждого потока своя копия (routeCipher)
+ */
+struct lb3_route {
+    int columns; ///< Количество столбцов
+    route path; ///< Маршрут чтения
+    uint64_t id; ///< Уникальный номер шифра (адрес может быть использован повторно)
+};
+
+namespace {
+
+thread_local std::string lastError; ///< Текст последней ошибки потока
+
+std::atomic<uint64_t> nextRouteId{1}; ///< Номер следующего созданного lb3_route
+
+/**
+ * @brief Объект code текущего потока для шифра
+ * @param[in] cipher Шифр
+ * @return Объект code, планы которого сохраняются между текстами и вызовами
+ * @details Поток хранит объект для последнего использованного шифра.
+ *          Объект создается по тексту-заглушке из одной строки: ключ
+ *          проверяется по числу символов каждого текста в encryptionUtf8
+ *          и transcriptUtf8
+ */
+code& routeCipher(const lb3_route* cipher) {
+    thread_local uint64_t id = 0;
+    thread_local std::unique_ptr<code> cached;
+    if (id != cipher->id) {
+        cached.reset(new code(cipher->columns, std::string(cipher->columns, 'A'), cipher->path));
+        id = cipher->id;
+    }
+    return *cached;
+}
+
+/**
+ * @class bufferTooSmall
+ * @brief Результат не помещается в буфер вызывающей стороны
+ */
+class bufferTooSmall: public std::runtime_error {
+    public:
+        bufferTooSmall(): std::runtime_error("Не хватает места в буфере результата") {}
+};
+
+/**
+ * @brief Выполнение действия с переводом исключений в коды результата
+ * @param[in] action Действие
+ * @return LB3_OK или код ошибки
+ */
+template <typename F>
+lb3_status guard(F action) {
+    try {
+        action();
+        return LB3_OK;
+    } catch (const bufferTooSmall& e) {
+        lastError = e.what();
+        return LB3_BUFFER_TOO_SMALL;
+    } catch (const std::invalid_argument& e) {
+        lastError = e.what();
+        return LB3_INVALID_ARGUMENT;
+    } catch (const std::bad_alloc&) {
+        lastError = "Не удалось выделить память";
+        return LB3_NO_MEMORY;
+    } catch (const std::exception& e) {
+        lastError = e.what();
+        return LB3_INTERNAL;
+    }
+}
+
+/**
+ * @brief Общий цикл пакетной обработки
+ * @param[in] transform Преобразование одного текста
+ * @return Код первой ошибки или LB3_OK
+ */
+template <typename F>
+lb3_status batch(const lb3_slice* in, size_t count, char* out, size_t capacity,
+                 size_t* offsets, lb3_status* statuses, F transform) {
+    lb3_status result = LB3_OK;
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        offsets[i] = pos;
+        lb3_status s = guard([&] {
+            std::string r = transform(std::string(in[i].data, in[i].size));
+            if (r.size() > capacity - pos)
+                throw bufferTooSmall();
+            memcpy(out + pos, r.data(), r.size());
+            pos += r.size();
+        });
+        if (statuses)
+            statuses[i] = s;
+        if (result == LB3_OK)
+            result = s;
+    }
+    offsets[count] = pos;
+    return result;
+}
+
+}
+
+/**
+ * @brief Текст последней ошибки в текущем потоке
+ * @return Строка UTF-8
+ */
+const char* lb3_last_error(void) {
+    return lastError.c_str();
+}
+
+/**
+ * @brief Создание шифра modAlphaCipher
+ * @param[in] key Ключ
+ * @param[out] out Созданный шифр
+ * @return LB3_OK или код ошибки
+ */
+lb3_status lb3_alpha_new(const char* key, lb3_alpha** out) {
+    *out = nullptr;
+    return guard([&] { *out = new lb3_alpha{modAlphaCipher(key ? key : "")}; });
+}
+
+/**
+ * @brief Удаление шифра modAlphaCipher
+ * @param[in] cipher Шифр
+ */
+void lb3_alpha_free(lb3_alpha* cipher) {
+    delete cipher;
+}
+
+/**
+ * @brief Пакетное шифрование modAlphaCipher
+ */
+lb3_status lb3_alpha_encrypt_batch(lb3_alpha* cipher, const lb3_slice* in, size_t count,
+                                   char* out, size_t capacity, size_t* offsets,
+                                   lb3_status* statuses) {
+    return batch(in, count, out, capacity, offsets, statuses,
+                 [cipher](const std::string& s) { return cipher->cipher.encrypt(s); });
+}
+
+/**
+ * @brief Пакетное дешифрование modAlphaCipher
+ */
+lb3_status lb3_alpha_decrypt_batch(lb3_alpha* cipher, const lb3_slice* in, size_t count,
+                                   char* out, size_t capacity, size_t* offsets,
+                                   lb3_status* statuses) {
+    return batch(in, count, out, capacity, offsets, statuses,
+                 [cipher](const std::string& s) { return cipher->cipher.decrypt(s); });
+}
+
+/**
+ * @brief Создание шифра маршрутной перестановки
+ * @param[in] columns Количество столбцов таблицы
+ * @param[in] kind Маршрут чтения
+ * @param[in] keyword Ключевое слово для LB3_ROUTE_KEYWORD
+ * @param[out] out Созданный шифр
+ * @return LB3_OK или код ошибки
+ */
+lb3_status lb3_route_new(int columns, lb3_route_kind kind, const char* keyword, lb3_route** out) {
+    *out = nullptr;
+    return guard([&] {
+        if (columns < 2)
+            throw cipher_error("Ключ некорректного размера");
+        route path = route::columns();
+        switch (kind) {
+        case LB3_ROUTE_COLUMNS:
+            break;
+        case LB3_ROUTE_SPIRAL:
+            path = route::spiralRoute();
+            break;
+        case LB3_ROUTE_SNAKE:
+            path = route::snakeRoute();
+            break;
+        case LB3_ROUTE_KEYWORD:
+            path = route::byKeyword(keyword ? keyword : "");
+            path.check(columns);
+            break;
+        default:
+            throw cipher_error("Неизвестный маршрут");
+        }
+        *out = new lb3_route{columns, path, nextRouteId++};
+    });
+}
+
+/**
+ * @brief Удаление шифра маршрутной перестановки
+ * @param[in] cipher Шифр
+ */
+void lb3_route_free(lb3_route* cipher) {
+    delete cipher;
+}
+
+/**
+ * @brief Пакетное шифрование маршрутной перестановкой
+ */
+lb3_status lb3_route_encrypt_batch(const lb3_route* cipher, const lb3_slice* in, size_t count,
+                                   char* out, size_t capacity, size_t* offsets,
+                                   lb3_status* statuses) {
+    return batch(in, count, out, capacity, offsets, statuses, [cipher](const std::string& s) {
+        return routeCipher(cipher).encryptionUtf8(s);
+    });
+}
+
+/**
+ * @brief Пакетное дешифрование маршрутной перестановкой
+ */
+lb3_status lb3_route_decrypt_batch(const lb3_route* cipher, const lb3_slice* in, size_t count,
+                                   char* out, size_t capacity, size_t* offsets,
+                                   lb3_status* statuses) {
+    return batch(in, count, out, capacity, offsets, statuses, [cipher](const std::string& s) {
+        return routeCipher(cipher).transcriptUtf8(s, s);
+    });
+}
@@ -0,0 +1,144 @@
+/**
+ * @file lb3cipher.h
+ * @brief C-интерфейс библиотеки шифров modAlphaCipher и code
+ * @author Назарова Софья
+ * @date 2025
+ * @details Все функции пакетные: за один вызов обрабатывается массив текстов,
+ *          результаты пишутся подряд в один буфер вызывающей стороны.
+ *          Исключения C++ не выходят за границу библиотеки - ошибки
+ *          возвращаются кодами lb3_status, текст последней ошибки потока
+ *          доступен через lb3_last_error()
+ */
+
+#ifndef LB3CIPHER_H
+#define LB3CIPHER_H
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#  define LB3_API __declspec(dllexport)
+#else
+#  define LB3_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Коды результата
+ */
+typedef enum lb3_status {
+    LB3_OK = 0,                 /**< Успешно */
+    LB3_INVALID_ARGUMENT = 1,   /**< Невалидный ключ или текст (cipher_error) */
+    LB3_BUFFER_TOO_SMALL = 2,   /**< Не хватает места в буфере результата */
+    LB3_NO_MEMORY = 3,          /**< Не удалось выделить память */
+    LB3_INTERNAL = 4            /**< Прочие ошибки */
+} lb3_status;
+
+/**
+ * @brief Маршруты чтения таблицы для шифра маршрутной перестановки
+ */
+typedef enum lb3_route_kind {
+    LB3_ROUTE_COLUMNS = 0,  /**< По столбцам справа налево */
+    LB3_ROUTE_SPIRAL = 1,   /**< По спирали */
+    LB3_ROUTE_SNAKE = 2,    /**< Змейкой */
+    LB3_ROUTE_KEYWORD = 3   /**< По ключевому слову */
+} lb3_route_kind;
+
+/**
+ * @brief Текст в UTF-8, не обязательно завершенный нулем
+ */
+typedef struct lb3_slice {
+    const char* data;   /**< Начало текста */
+    size_t size;        /**< Длина в байтах */
+} lb3_slice;
+
+typedef struct lb3_alpha lb3_alpha;  /**< Шифр modAlphaCipher */
+typedef struct lb3_route lb3_route;  /**< Шифр маршрутной перестановки */
+
+/**
+ * @brief Текст последней ошибки в текущем потоке
+ * @return Строка UTF-8 (пустая, если ошибок не было)
+ */
+LB3_API const char* lb3_last_error(void);
+
+/**
+ * @brief Создание шифра modAlphaCipher
+ * @param[in] key Ключ в UTF-8, завершенный нулем
+ * @param[out] out Созданный шифр
+ * @return LB3_OK или код ошибки
+ */
+LB3_API lb3_status lb3_alpha_new(const char* key, lb3_alpha** out);
+
+/**
+ * @brief Удаление шифра modAlphaCipher
+ * @param[in] cipher Шифр (NULL допустим)
+ */
+LB3_API void lb3_alpha_free(lb3_alpha* cipher);
+
+/**
+ * @brief Пакетное шифрование modAlphaCipher
+ * @param[in] cipher Шифр (можно использовать из нескольких потоков одновременно)
+ * @param[in] in Тексты
+ * @param[in] count Количество текстов
+ * @param[out] out Буфер результатов; достаточно суммарной длины входных текстов
+ * @param[in] capacity Размер буфера out
+ * @param[out] offsets Массив из count + 1 элементов: i-й результат занимает
+ *                     out[offsets[i]] .. out[offsets[i + 1]]
+ * @param[out] statuses Массив из count кодов результата по каждому тексту (может быть NULL)
+ * @return LB3_OK, если обработаны все тексты, иначе код первой ошибки;
+ *         при ошибке текста его результат пуст, остальные тексты обрабатываются
+ */
+LB3_API lb3_status lb3_alpha_encrypt_batch(lb3_alpha* cipher, const lb3_slice* in, size_t count,
+                                           char* out, size_t capacity, size_t* offsets,
+                                           lb3_status* statuses);
+
+/**
+ * @brief Пакетное дешифрование modAlphaCipher
+ * @details Параметры и результат - как у lb3_alpha_encrypt_batch()
+ */
+LB3_API lb3_status lb3_alpha_decrypt_batch(lb3_alpha* cipher, const lb3_slice* in, size_t count,
+                                           char* out, size_t capacity, size_t* offsets,
+                                           lb3_status* statuses);
+
+/**
+ * @brief Создание шифра маршрутной перестановки
+ * @param[in] columns Количество столбцов таблицы
+ * @param[in] kind Маршрут чтения
+ * @param[in] keyword Ключевое слово для LB3_ROUTE_KEYWORD (иначе NULL)
+ * @param[out] out Созданный шифр
+ * @return LB3_OK или код ошибки
+ */
+LB3_API lb3_status lb3_route_new(int columns, lb3_route_kind kind, const char* keyword,
+                                 lb3_route** out);
+
+/**
+ * @brief Удаление шифра маршрутной перестановки
+ * @param[in] cipher Шифр (NULL допустим)
+ */
+LB3_API void lb3_route_free(lb3_route* cipher);
+
+/**
+ * @brief Пакетное шифрование маршрутной перестановкой
+ * @details Тексты - латинские и русские буквы и пробелы в UTF-8, переставляются
+ *          целые символы (code::encryptionUtf8). Параметры и результат -
+ *          как у lb3_alpha_encrypt_batch()
+ */
+LB3_API lb3_status lb3_route_encrypt_batch(const lb3_route* cipher, const lb3_slice* in, size_t count,
+                                           char* out, size_t capacity, size_t* offsets,
+                                           lb3_status* statuses);
+
+/**
+ * @brief Пакетное дешифрование маршрутной перестановкой
+ * @details Параметры и результат - как у lb3_alpha_encrypt_batch()
+ */
+LB3_API lb3_status lb3_route_decrypt_batch(const lb3_route* cipher, const lb3_slice* in, size_t count,
+                                           char* out, size_t capacity, size_t* offsets,
+                                           lb3_status* statuses);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
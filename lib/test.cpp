@@ -0,0 +1,142 @@
+/**
+ * @file test.cpp
+ * @brief Тесты для C-интерфейса библиотеки шифров
+ * @author Назарова Софья
+ * @date 2025
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include "lb3cipher.h"
+#include <string>
+#include <vector>
+
+/**
+ * @test Suite AlphaApiTest
+ * @brief Тесты для пакетных функций modAlphaCipher
+ */
+SUITE(AlphaApiTest)
+{
+    /**
+     * @test Batch
+     * @brief Пакет с невалидным текстом: остальные тексты обработаны
+     */
+    TEST(Batch) {
+        lb3_alpha* cipher = nullptr;
+        CHECK_EQUAL(LB3_OK, lb3_alpha_new("БОРЩ", &cipher));
+        std::string a = "СУП", b = "*_*", c = "Я";
+        lb3_slice in[] = {{a.data(), a.size()}, {b.data(), b.size()}, {c.data(), c.size()}};
+        char out[16];
+        size_t offsets[4];
+        lb3_status statuses[3];
+        CHECK_EQUAL(LB3_INVALID_ARGUMENT, lb3_alpha_encrypt_batch(cipher, in, 3, out, sizeof(out), offsets, statuses));
+        CHECK_EQUAL(LB3_OK, statuses[0]);
+        CHECK_EQUAL(LB3_INVALID_ARGUMENT, statuses[1]);
+        CHECK_EQUAL(LB3_OK, statuses[2]);
+        CHECK_EQUAL("ТВА", std::string(out + offsets[0], offsets[1] - offsets[0]));
+        CHECK_EQUAL(offsets[1], offsets[2]);
+        CHECK_EQUAL("А", std::string(out + offsets[2], offsets[3] - offsets[2]));
+        lb3_alpha_free(cipher);
+    }
+
+    /**
+     * @test BadKey
+     * @brief Слабый ключ: код ошибки и текст ошибки
+     */
+    TEST(BadKey) {
+        lb3_alpha* cipher = nullptr;
+        CHECK_EQUAL(LB3_INVALID_ARGUMENT, lb3_alpha_new("ЙЙЙ", &cipher));
+        CHECK(cipher == nullptr);
+        CHECK_EQUAL(std::string("WeakKey"), lb3_last_error());
+    }
+
+    /**
+     * @test SmallBuffer
+     * @brief Результат не помещается в буфер
+     */
+    TEST(SmallBuffer) {
+        lb3_alpha* cipher = nullptr;
+        lb3_alpha_new("БОРЩ", &cipher);
+        std::string a = "СУП";
+        lb3_slice in[] = {{a.data(), a.size()}};
+        char out[4];
+        size_t offsets[2];
+        CHECK_EQUAL(LB3_BUFFER_TOO_SMALL, lb3_alpha_encrypt_batch(cipher, in, 1, out, sizeof(out), offsets, nullptr));
+        lb3_alpha_free(cipher);
+    }
+}
+
+/**
+ * @test Suite RouteApiTest
+ * @brief Тесты для пакетных функций маршрутной перестановки
+ */
+SUITE(RouteApiTest)
+{
+    /**
+     * @test RoundTrip
+     * @brief Шифрование и дешифрование пакета
+     */
+    TEST(RoundTrip) {
+        lb3_route* cipher = nullptr;
+        CHECK_EQUAL(LB3_OK, lb3_route_new(3, LB3_ROUTE_COLUMNS, nullptr, &cipher));
+        std::string a = "PRIVET", b = "ПРИВЕТ";
+        lb3_slice in[] = {{a.data(), a.size()}, {b.data(), b.size()}};
+        char out[32];
+        size_t offsets[3];
+        CHECK_EQUAL(LB3_OK, lb3_route_encrypt_batch(cipher, in, 2, out, sizeof(out), offsets, nullptr));
+        std::string ea(out + offsets[0], offsets[1] - offsets[0]);
+        std::string eb(out + offsets[1], offsets[2] - offsets[1]);
+        CHECK_EQUAL("ITREPV", ea);
+        CHECK_EQUAL("ИТРЕПВ", eb);
+
+        lb3_slice back[] = {{ea.data(), ea.size()}, {eb.data(), eb.size()}};
+        CHECK_EQUAL(LB3_OK, lb3_route_decrypt_batch(cipher, back, 2, out, sizeof(out), offsets, nullptr));
+        CHECK_EQUAL(a + b, std::string(out, offsets[2]));
+        lb3_route_free(cipher);
+    }
+
+    /**
+     * @test KeyPerText
+     * @brief Ключ проверяется по числу символов каждого текста пакета
+     */
+    TEST(KeyPerText) {
+        lb3_route* wide = nullptr;
+        lb3_route* narrow = nullptr;
+        CHECK_EQUAL(LB3_OK, lb3_route_new(8, LB3_ROUTE_COLUMNS, nullptr, &wide));
+        CHECK_EQUAL(LB3_OK, lb3_route_new(3, LB3_ROUTE_COLUMNS, nullptr, &narrow));
+        std::string a = "ПРИВЕТ", b = "ПРИВЕТ МИР ДРУГ";
+        lb3_slice in[] = {{a.data(), a.size()}, {b.data(), b.size()}};
+        char out[64];
+        size_t offsets[3];
+        lb3_status statuses[2];
+        CHECK_EQUAL(LB3_INVALID_ARGUMENT, lb3_route_encrypt_batch(wide, in, 2, out, sizeof(out), offsets, statuses));
+        CHECK_EQUAL(LB3_INVALID_ARGUMENT, statuses[0]);
+        CHECK_EQUAL(LB3_OK, statuses[1]);
+        CHECK_EQUAL(0u, offsets[1]);
+
+        CHECK_EQUAL(LB3_OK, lb3_route_encrypt_batch(narrow, in, 1, out, sizeof(out), offsets, nullptr));
+        CHECK_EQUAL("ИТРЕПВ", std::string(out, offsets[1]));
+        CHECK_EQUAL(LB3_INVALID_ARGUMENT, lb3_route_encrypt_batch(wide, in, 1, out, sizeof(out), offsets, nullptr));
+        lb3_route_free(wide);
+        lb3_route_free(narrow);
+    }
+
+    /**
+     * @test BadRoute
+     * @brief Невалидный ключ или ключевое слово
+     */
+    TEST(BadRoute) {
+        lb3_route* cipher = nullptr;
+        CHECK_EQUAL(LB3_INVALID_ARGUMENT, lb3_route_new(1, LB3_ROUTE_COLUMNS, nullptr, &cipher));
+        CHECK_EQUAL(LB3_INVALID_ARGUMENT, lb3_route_new(3, LB3_ROUTE_KEYWORD, "ZEBRA", &cipher));
+        CHECK(cipher == nullptr);
+    }
+}
+
+/**
+ * @brief Главная функция для запуска тестов
+ * @return Код завершения (0 - все тесты прошли успешно)
+ */
+int main()
+{
+    return UnitTest::RunAllTests();
+}